@@ -0,0 +1,143 @@
+#include <bits/stdc++.h>
+using namespace std;
+
+#include <celony/graph/csr_graph.hpp>
+
+/**
+ * @brief Centroid decomposition for distance queries on trees.
+ *
+ * Recursively removes a centroid of every component, which gives a centroid
+ * tree of depth at most \f$\log_2 N\f$. Every path of the original tree
+ * passes through the lowest common centroid ancestor of its endpoints, so
+ * distance queries reduce to the \f$O(\log N)\f$ centroid ancestors of a
+ * vertex.
+ *
+ * The distance from every vertex to its centroid ancestor at level l is
+ * stored flat in level-major order, so a query touches one entry per level.
+ * Construction is iterative and reuses a single set of BFS buffers.
+ *
+ * @note Also supports online "mark vertex / nearest marked vertex" queries.
+ */
+class centroid_decomposition {
+  int n;
+  vector<int> par, lvl; // Centroid tree parents (-1 for the root) and levels.
+  vector<int> dist;     // dist[l * n + v], distance to the level l ancestor.
+  vector<int> best;     // Distance from each centroid to its nearest mark.
+
+public:
+  /**
+   * @brief Constructs the centroid decomposition of a tree.
+   *
+   * Time Complexity: \f$O(N \log N)\f$
+   *
+   * @tparam G Graph type, vector<vector<int>> or csr_graph.
+   * @param g The adjacency list representation of the tree.
+   */
+  template <typename G>
+  centroid_decomposition(const G &g)
+      : n(g.size()), par(n, -1), lvl(n, -1), best(n, INT_MAX) {
+    // Components are given by any of their vertices together with the
+    // centroid that split them off, processed depth first.
+    vector<pair<int, int>> st;
+    vector<int> q(n), from(n), sz(n);
+    dist.reserve((__lg(max(n, 1)) + 1) * n); // levels are < log2(N) + 1
+    for (int r = 0; r < n; r++) {
+      if (lvl[r] != -1)
+        continue;
+      for (st.push_back({r, -1}); !st.empty();) {
+        auto [s, p] = st.back();
+        st.pop_back();
+        int l = p == -1 ? 0 : lvl[p] + 1, m = 1;
+        q[0] = s, from[s] = -1, sz[s] = 1;
+        for (int i = 0; i < m; i++)
+          for (int v : g[q[i]])
+            if (lvl[v] == -1 && v != from[q[i]])
+              from[v] = q[i], sz[v] = 1, q[m++] = v;
+        // Vertices with at least half of the component below them form a
+        // path from s, and the deepest of them, the first one in reverse BFS
+        // order, is a centroid.
+        int c = -1;
+        for (int i = m - 1; i >= 0; i--) {
+          int u = q[i];
+          if (c == -1 && 2 * sz[u] >= m)
+            c = u;
+          if (i > 0)
+            sz[from[u]] += sz[u];
+        }
+        par[c] = p, lvl[c] = l;
+        if ((int)dist.size() < (l + 1) * n)
+          dist.resize((l + 1) * n);
+        int *d = &dist[l * n];
+        q[0] = c, from[c] = -1, d[c] = 0;
+        for (int i = 0, k = 1; i < k; i++)
+          for (int v : g[q[i]])
+            if (lvl[v] == -1 && v != from[q[i]])
+              from[v] = q[i], d[v] = d[q[i]] + 1, q[k++] = v;
+        for (int v : g[c])
+          if (lvl[v] == -1)
+            st.push_back({v, c});
+      }
+    }
+  }
+
+  /**
+   * @brief Returns the parent of a vertex in the centroid tree.
+   *
+   * Time Complexity: \f$O(1)\f$
+   *
+   * @param v Vertex index.
+   * @return The centroid whose removal separated v, or -1 for a root.
+   */
+  int parent(int v) const { return par[v]; }
+
+  /**
+   * @brief Returns the level of a vertex in the centroid tree.
+   *
+   * Time Complexity: \f$O(1)\f$
+   *
+   * @param v Vertex index.
+   * @return The depth of v in the centroid tree, 0 for a root.
+   */
+  int level(int v) const { return lvl[v]; }
+
+  /**
+   * @brief Returns the distance from a vertex to one of its centroid
+   * ancestors.
+   *
+   * Time Complexity: \f$O(1)\f$
+   *
+   * @param v Vertex index.
+   * @param l Level of the ancestor, at most level(v).
+   * @return The number of edges between v and its level l centroid ancestor.
+   */
+  int distance(int v, int l) const { return dist[l * n + v]; }
+
+  /**
+   * @brief Marks a vertex.
+   *
+   * Time Complexity: \f$O(\log N)\f$
+   *
+   * @param v Vertex index.
+   */
+  void mark(int v) {
+    for (int c = v; c != -1; c = par[c])
+      best[c] = min(best[c], dist[lvl[c] * n + v]);
+  }
+
+  /**
+   * @brief Finds the distance from a vertex to the nearest marked vertex.
+   *
+   * Time Complexity: \f$O(\log N)\f$
+   *
+   * @param v Vertex index.
+   * @return The number of edges to the nearest marked vertex in the same tree,
+   * or -1 if there is none.
+   */
+  int nearest(int v) const {
+    int ans = INT_MAX;
+    for (int c = v; c != -1; c = par[c])
+      if (best[c] != INT_MAX)
+        ans = min(ans, best[c] + dist[lvl[c] * n + v]);
+    return ans == INT_MAX ? -1 : ans;
+  }
+};
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+#include <bits/stdc++.h>
+using namespace std;
+
+/**
+ * @brief Graph adjacency stored in compressed sparse row (CSR) form.
+ *
+ * All adjacency lists live in one contiguous targets array, and the
+ * neighbours of u are targets[offsets[u]..offsets[u + 1]). Compared to
+ * vector<vector<int>> this uses two allocations in total and scans
+ * neighbours sequentially. Since g[u] is iterable and g.size() is the vertex
+ * count, it can be passed wherever a graph template parameter is accepted.
+ */
+struct csr_graph {
+  vector<int> offsets, targets;
+
+  /**
+   * @brief A contiguous range of neighbours.
+   */
+  struct range {
+    const int *b, *e;
+    const int *begin() const { return b; }
+    const int *end() const { return e; }
+    int size() const { return e - b; }
+    int operator[](int i) const { return b[i]; }
+  };
+
+  /**
+   * @brief Constructs the graph from existing CSR arrays.
+   *
+   * Time Complexity: \f$O(1)\f$
+   *
+   * @param offsets Row offsets of size N + 1, ending with targets.size().
+   * @param targets Concatenated adjacency lists.
+   */
+  csr_graph(vector<int> offsets, vector<int> targets)
+      : offsets(std::move(offsets)), targets(std::move(targets)) {}
+
+  /**
+   * @brief Constructs the graph from an edge list using a counting sort.
+   *
+   * Time Complexity: \f$O(N + M)\f$
+   *
+   * @param n Number of vertices.
+   * @param edges Edges (u, v).
+   * @param directed If false, every edge is also added as (v, u).
+   */
+  csr_graph(int n, const vector<pair<int, int>> &edges, bool directed = false)
+      : offsets(n + 1), targets(edges.size() * (directed ? 1 : 2)) {
+    for (auto [u, v] : edges) {
+      offsets[u + 1]++;
+      if (!directed)
+        offsets[v + 1]++;
+    }
+    partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    vector<int> pos(offsets.begin(), offsets.end() - 1);
+    for (auto [u, v] : edges) {
+      targets[pos[u]++] = v;
+      if (!directed)
+        targets[pos[v]++] = u;
+    }
+  }
+
+  /**
+   * @brief Number of vertices.
+   */
+  int size() const { return offsets.size() - 1; }
+
+  /**
+   * @brief Neighbours of u.
+   */
+  range operator[](int u) const {
+    return {targets.data() + offsets[u], targets.data() + offsets[u + 1]};
+  }
+};
\ No newline at end of file
@@ -0,0 +1,309 @@
+#include <bits/stdc++.h>
+using namespace std;
+
+/**
+ * @brief Link-Cut Tree for path queries on a dynamic forest.
+ *
+ * Represents every tree of the forest as a set of preferred paths, each stored
+ * in a splay tree keyed by depth. Edges can be added and removed at any time,
+ * and paths between any two connected vertices can be aggregated, without
+ * rebuilding anything.
+ *
+ * Nodes live in per-field arrays allocated once for all N vertices and are
+ * linked by 32-bit indices, with index 0 reserved as the null node, so no
+ * operation allocates memory.
+ *
+ * @tparam T Value type.
+ * @tparam Combine Binary associative operation for combining path values.
+ * @tparam Commutative Whether Combine is commutative. If false, the aggregate
+ * of every splay subtree is also kept in reverse order, so re-rooting can
+ * flip paths and queries combine values in order from the first vertex to the
+ * second.
+ *
+ * @note All operations are \f$O(\log N)\f$ amortized.
+ * @note Vertices are zero-indexed.
+ */
+template <typename T, typename Combine, bool Commutative = true>
+class link_cut_tree {
+  using node = uint32_t; // Node index, vertex u is node u + 1.
+
+  vector<node> lc, rc, par; // Splay children, splay parent or path parent.
+  vector<uint8_t> rev;      // Whether the children of a node must be swapped.
+  vector<T> val, agg, ragg; // Values and subtree answers (ragg reversed).
+  Combine combine;
+
+  vector<node> path; // Scratch stack for splay.
+
+  bool _is_root(node x) const {
+    node p = par[x];
+    return !p || (lc[p] != x && rc[p] != x);
+  }
+  void _reverse(node x) {
+    if (x) {
+      swap(lc[x], rc[x]);
+      if constexpr (!Commutative)
+        swap(agg[x], ragg[x]);
+      rev[x] ^= 1;
+    }
+  }
+  void _push(node x) {
+    if (rev[x]) {
+      _reverse(lc[x]);
+      _reverse(rc[x]);
+      rev[x] = false;
+    }
+  }
+  void _update(node x) {
+    node l = lc[x], r = rc[x];
+    agg[x] = l ? combine(agg[l], val[x]) : val[x];
+    if (r)
+      agg[x] = combine(agg[x], agg[r]);
+    if constexpr (!Commutative) {
+      ragg[x] = r ? combine(ragg[r], val[x]) : val[x];
+      if (l)
+        ragg[x] = combine(ragg[x], ragg[l]);
+    }
+  }
+  void _rotate(node x) {
+    node p = par[x], g = par[p];
+    if (!_is_root(p))
+      (lc[g] == p ? lc[g] : rc[g]) = x;
+    if (lc[p] == x) {
+      lc[p] = rc[x];
+      if (rc[x])
+        par[rc[x]] = p;
+      rc[x] = p;
+    } else {
+      rc[p] = lc[x];
+      if (lc[x])
+        par[lc[x]] = p;
+      lc[x] = p;
+    }
+    par[p] = x;
+    par[x] = g;
+    _update(p);
+    _update(x);
+  }
+  void _splay(node x) {
+    path.clear();
+    for (node y = x;; y = par[y]) {
+      path.push_back(y);
+      if (_is_root(y))
+        break;
+    }
+    for (int i = path.size() - 1; i >= 0; i--)
+      _push(path[i]);
+    while (!_is_root(x)) {
+      node p = par[x], g = par[p];
+      if (!_is_root(p))
+        _rotate((lc[p] == x) == (lc[g] == p) ? p : x);
+      _rotate(x);
+    }
+  }
+  // Makes the root-to-x path preferred, with x at the root of its splay tree.
+  // Returns the last node whose path was joined, the LCA for a second access.
+  node _access(node x) {
+    node last = 0;
+    for (node y = x; y; y = par[y]) {
+      _splay(y);
+      rc[y] = last;
+      _update(y);
+      last = y;
+    }
+    _splay(x);
+    return last;
+  }
+  void _reroot(node x) {
+    _access(x);
+    _reverse(x);
+  }
+  node _find_root(node x) {
+    _access(x);
+    for (;; x = lc[x]) {
+      _push(x);
+      if (!lc[x])
+        break;
+    }
+    _splay(x);
+    return x;
+  }
+
+public:
+  /**
+   * @brief Constructs a forest of isolated vertices with uniform values.
+   *
+   * Time Complexity: \f$O(N)\f$
+   *
+   * @param n Number of vertices.
+   * @param v Initial value for all vertices.
+   * @param combine Binary associative operation for path queries.
+   */
+  link_cut_tree(int n, const T &v, const Combine &combine)
+      : link_cut_tree(vector<T>(n, v), combine) {}
+
+  /**
+   * @brief Constructs a forest of isolated vertices with specified values.
+   *
+   * Time Complexity: \f$O(N)\f$
+   *
+   * @param v Initial values for vertices.
+   * @param combine Binary associative operation for path queries.
+   */
+  link_cut_tree(const vector<T> &v, const Combine &combine)
+      : combine(combine) {
+    int n = v.size() + 1;
+    lc.resize(n), rc.resize(n), par.resize(n), rev.resize(n);
+    val.reserve(n);
+    val.push_back(T{});
+    val.insert(val.end(), v.begin(), v.end());
+    agg = val;
+    if constexpr (!Commutative)
+      ragg = val;
+  }
+
+  /**
+   * @brief Makes a vertex the root of its tree.
+   *
+   * Time Complexity: \f$O(\log N)\f$ amortized
+   *
+   * @param u Vertex index.
+   */
+  void reroot(int u) { _reroot(u + 1); }
+
+  /**
+   * @brief Finds the root of the tree containing a vertex.
+   *
+   * Time Complexity: \f$O(\log N)\f$ amortized
+   *
+   * @param u Vertex index.
+   * @return The current root of the tree containing u.
+   */
+  int find_root(int u) { return _find_root(u + 1) - 1; }
+
+  /**
+   * @brief Checks whether two vertices are in the same tree.
+   *
+   * Time Complexity: \f$O(\log N)\f$ amortized
+   *
+   * @param u First vertex index.
+   * @param v Second vertex index.
+   * @return True if u and v are connected.
+   */
+  bool connected(int u, int v) { return find_root(u) == find_root(v); }
+
+  /**
+   * @brief Adds the edge (u, v), joining two trees.
+   *
+   * The tree of v keeps its root.
+   *
+   * Time Complexity: \f$O(\log N)\f$ amortized
+   *
+   * @param u First vertex index.
+   * @param v Second vertex index.
+   * @return True if the edge was added, false if u and v were already
+   * connected.
+   */
+  bool link(int u, int v) {
+    node x = u + 1, y = v + 1;
+    _reroot(x);
+    if (_find_root(y) == x)
+      return false;
+    par[x] = y;
+    return true;
+  }
+
+  /**
+   * @brief Removes the edge (u, v), splitting a tree.
+   *
+   * Time Complexity: \f$O(\log N)\f$ amortized
+   *
+   * @param u First vertex index.
+   * @param v Second vertex index.
+   * @return True if the edge was removed, false if there was no such edge.
+   */
+  bool cut(int u, int v) {
+    node x = u + 1, y = v + 1;
+    _reroot(x);
+    _access(y);
+    // The path x..y is now the splay tree of y, and is a single edge only if
+    // x is the left child of y with nothing between them.
+    if (lc[y] != x || rc[x])
+      return false;
+    lc[y] = par[x] = 0;
+    _update(y);
+    return true;
+  }
+
+  /**
+   * @brief Computes the lowest common ancestor of two vertices under the
+   * current root.
+   *
+   * Time Complexity: \f$O(\log N)\f$ amortized
+   *
+   * @param u First vertex index.
+   * @param v Second vertex index.
+   * @return The lowest common ancestor of u and v, or -1 if they are not
+   * connected.
+   */
+  int lca(int u, int v) {
+    if (!connected(u, v))
+      return -1;
+    _access(u + 1);
+    return _access(v + 1) - 1;
+  }
+
+  /**
+   * @brief Returns the value at a vertex.
+   *
+   * Time Complexity: \f$O(1)\f$
+   *
+   * @param u Vertex index.
+   */
+  T get(int u) const { return val[u + 1]; }
+
+  /**
+   * @brief Updates the value at a vertex using the combine operation.
+   *
+   * Time Complexity: \f$O(\log N)\f$ amortized
+   *
+   * @param u Vertex index.
+   * @param v Value to combine with the current vertex value.
+   */
+  void update(int u, const T &v) { set(u, combine(val[u + 1], v)); }
+
+  /**
+   * @brief Sets the value at a vertex, replacing the current value.
+   *
+   * Time Complexity: \f$O(\log N)\f$ amortized
+   *
+   * @param u Vertex index.
+   * @param v New value.
+   */
+  void set(int u, const T &v) {
+    node x = u + 1;
+    _access(x);
+    val[x] = v;
+    _update(x);
+  }
+
+  /**
+   * @brief Queries the path between two connected vertices using the combine
+   * operation.
+   *
+   * Makes u the root of its tree.
+   *
+   * Time Complexity: \f$O(\log N)\f$ amortized
+   *
+   * @param u First vertex index.
+   * @param v Second vertex index.
+   * @return The combined result of all vertex values on the path from u to v,
+   * in path order if Commutative is false.
+   *
+   * @note u and v must be connected.
+   */
+  T query(int u, int v) {
+    _reroot(u + 1);
+    _access(v + 1);
+    return agg[v + 1];
+  }
+};
\ No newline at end of file
@@ -1,6 +1,9 @@
+#pragma once
 #include <bits/stdc++.h>
 using namespace std;
 
+#include <celony/graph/csr_graph.hpp>
+
 /**
  * @brief Lowest Common Ancestor (LCA) data structure using ±1 RMQ reduction.
  *
@@ -15,89 +18,132 @@ using namespace std;
  * @note The tree must be connected and rooted at the specified root vertex.
  */
 class lowest_common_ancestor {
-  vector<int> tour, start, end, node, depth, mask;
-  vector<vector<int>> dp;
-  vector<vector<vector<int>>> blocks;
+  vector<int> tour, start, end, depth;
+  int b_size, b_cnt;
+  vector<uint16_t> mask;  // b_size - 1 <= 14 bits per block
+  vector<int> dp;         // dp[l * b_cnt + b], sparse table over blocks
+  vector<uint8_t> blocks; // blocks[(mask * b_size + l) * b_size + r]
+  // Nodes of depth d in preorder are level[level_start[d]..level_start[d+1]).
+  vector<int> level, level_start;
 
   int _min_by_depth(int i, int j) const {
     return depth[tour[i]] < depth[tour[j]] ? i : j;
   }
   int _lca_block(int b, int l, int r) const {
-    int b_size = max(1, (int)__lg(tour.size()) >> 1);
-    return blocks[mask[b]][l][r] + b * b_size;
+    return blocks[(mask[b] * b_size + l) * b_size + r] + b * b_size;
+  }
+
+  // LCA of the tour positions l <= r.
+  int _query(int l, int r) const {
+    int bl = l / b_size;
+    int br = r / b_size;
+    if (bl == br)
+      return tour[_lca_block(bl, l % b_size, r % b_size)];
+    int ans = _min_by_depth(_lca_block(bl, l % b_size, b_size - 1),
+                            _lca_block(br, 0, r % b_size));
+    if (bl + 1 < br) {
+      int l = __lg(br - bl - 1);
+      ans = _min_by_depth(ans, _min_by_depth(dp[l * b_cnt + bl + 1],
+                                             dp[l * b_cnt + br - (1 << l)]));
+    }
+    return tour[ans];
   }
 
-  template <typename R, typename... Args> friend class mo_tree;
+  template <typename Add, typename Erase, typename F, typename... Args>
+  friend class mo_tree;
 
 public:
   /**
    * @brief Constructs the LCA data structure for the given tree.
    *
+   * The Euler tour is built with an explicit stack, so arbitrarily deep trees
+   * do not overflow the call stack.
+   *
    * Time Complexity: \f$O(N)\f$
    * Space Complexity: \f$O(N)\f$
    *
+   * @tparam G Graph type, vector<vector<int>> or csr_graph.
    * @param g The adjacency list representation of the tree.
    * @param root The root vertex of the tree (default is 0).
    */
-  lowest_common_ancestor(const vector<vector<int>> &g, int root = 0) {
+  template <typename G>
+  lowest_common_ancestor(const G &g, int root = 0) {
     int n = g.size();
     tour.reserve(2 * n);
     start.resize(n);
     end.resize(n);
-    node.resize(2 * n);
     depth.resize(n);
-    auto dfs = [&](auto &self, int u, int p, int d) -> void {
-      node[start[u] = end[u] = tour.size()] = u;
+    struct frame {
+      int u, p;
+      decltype(g[0].begin()) it;
+    };
+    vector<frame> st;
+    st.reserve(n);
+    auto enter = [&](int u, int p, int d) {
+      start[u] = tour.size();
       depth[u] = d;
       tour.push_back(u);
-      for (int v : g[u]) {
-        if (v != p) {
-          self(self, v, u, d + 1);
-          tour.push_back(u);
-        }
-      }
-      node[end[u] = tour.size()] = u;
+      st.push_back({u, p, g[u].begin()});
     };
-    dfs(dfs, root, root, 0);
+    enter(root, root, 0);
+    while (!st.empty()) {
+      auto &[u, p, it] = st.back();
+      if (it == g[u].end()) {
+        end[u] = tour.size();
+        st.pop_back();
+        if (!st.empty())
+          tour.push_back(st.back().u);
+      } else if (int v = *it++; v != p)
+        enter(v, u, depth[u] + 1);
+    }
     int m = tour.size();
-    int b_size = max(1, __lg(m) >> 1);
-    int b_cnt = (m + b_size - 1) / b_size;
-    dp.resize(b_cnt, vector(__lg(b_cnt) + 1, 0));
+    level_start.assign(*max_element(depth.begin(), depth.end()) + 2, 0);
+    for (int i = 0; i < m; i++)
+      if (start[tour[i]] == i)
+        level_start[depth[tour[i]] + 1]++;
+    partial_sum(level_start.begin(), level_start.end(), level_start.begin());
+    level.resize(level_start.back());
+    vector<int> pos(level_start.begin(), level_start.end() - 1);
+    for (int i = 0; i < m; i++)
+      if (start[tour[i]] == i)
+        level[pos[depth[tour[i]]]++] = tour[i];
+    b_size = max(1, __lg(m) >> 1);
+    b_cnt = (m + b_size - 1) / b_size;
+    int lg = __lg(b_cnt);
+    dp.resize((lg + 1) * b_cnt);
+    mask.assign(b_cnt, 0);
     for (int i = 0, j = 0, b = 0; i < m; i++, j++) {
       if (j == b_size)
         j = 0, b++;
-      if (j == 0 || _min_by_depth(i, dp[b][0]) == i)
-        dp[b][0] = i;
+      if (j == 0 || _min_by_depth(i, dp[b]) == i)
+        dp[b] = i;
+      if (j > 0 && _min_by_depth(i - 1, i) == i - 1)
+        mask[b] |= 1 << (j - 1);
     }
-    for (int l = 1; l <= __lg(b_cnt); l++) {
+    for (int l = 1; l <= lg; l++) {
+      int *cur = &dp[l * b_cnt], *prv = &dp[(l - 1) * b_cnt];
       for (int i = 0; i < b_cnt; i++) {
         if (int j = i + (1 << (l - 1)); j >= b_cnt)
-          dp[i][l] = dp[i][l - 1];
+          cur[i] = prv[i];
         else
-          dp[i][l] = _min_by_depth(dp[i][l - 1], dp[j][l - 1]);
+          cur[i] = _min_by_depth(prv[i], prv[j]);
       }
     }
-    mask.resize(b_cnt);
-    for (int i = 0, j = 0, b = 0; i < m; i++, j++) {
-      if (j == b_size)
-        j = 0, b++;
-      if (j > 0 && (i >= m || _min_by_depth(i - 1, i) == i - 1))
-        mask[b] += 1 << (j - 1);
-    }
-    blocks.resize(1 << (b_size - 1));
+    blocks.resize((b_size << (b_size - 1)) * b_size);
+    vector<bool> done(1 << (b_size - 1));
     for (int b = 0; b < b_cnt; b++) {
       int msk = mask[b];
-      if (!blocks[msk].empty())
+      if (done[msk])
         continue;
-      blocks[msk].resize(b_size, vector(b_size, 0));
+      done[msk] = true;
+      uint8_t *blk = &blocks[msk * b_size * b_size];
       for (int l = 0; l < b_size; l++) {
-        blocks[msk][l][l] = l;
+        blk[l * b_size + l] = l;
         for (int r = l + 1; r < b_size; r++) {
-          blocks[msk][l][r] = blocks[msk][l][r - 1];
+          int x = blk[l * b_size + r - 1];
           if (b * b_size + r < m)
-            blocks[msk][l][r] =
-                _min_by_depth(b * b_size + blocks[msk][l][r], b * b_size + r) -
-                b * b_size;
+            x = _min_by_depth(b * b_size + x, b * b_size + r) - b * b_size;
+          blk[l * b_size + r] = x;
         }
       }
     }
@@ -113,21 +159,152 @@ public:
    * @return The index of the lowest common ancestor of u and v.
    */
   int query(int v, int u) const {
-    int l = start[v], r = start[u],
-        b_size = max(1, (int)__lg(tour.size()) >> 1);
+    int l = start[v], r = start[u];
     if (l > r)
       swap(l, r);
-    int bl = l / b_size;
-    int br = r / b_size;
-    if (bl == br)
-      return tour[_lca_block(bl, l % b_size, r % b_size)];
-    int ans = _min_by_depth(_lca_block(bl, l % b_size, b_size - 1),
-                            _lca_block(br, 0, r % b_size));
-    if (bl + 1 < br) {
-      int l = __lg(br - bl - 1);
-      ans = _min_by_depth(ans,
-                          _min_by_depth(dp[bl + 1][l], dp[br - (1 << l)][l]));
+    return _query(l, r);
+  }
+
+  /**
+   * @brief Computes the lowest common ancestors of many pairs of nodes.
+   *
+   * Queries are processed in chunks, in stages: the tour positions of the
+   * next chunk, then the block masks and sparse table entries, then the
+   * depths of the candidate answers are prefetched for the whole chunk before
+   * the next stage reads them. The cache misses of independent queries thus
+   * overlap instead of being paid one after another.
+   *
+   * Time Complexity: \f$O(Q)\f$
+   *
+   * @param q Pairs of node indices.
+   * @return The lowest common ancestor of each pair, in order.
+   */
+  vector<int> query_batch(const vector<pair<int, int>> &q) const {
+    constexpr int B = 64;
+    int m = q.size();
+    vector<int> ans(m);
+    array<array<int, 3>, B> c; // candidate tour positions of each query
+    for (int s = 0; s < m; s += B) {
+      int e = min(m, s + B);
+      for (int i = e; i < min(m, e + B); i++) {
+        __builtin_prefetch(&start[q[i].first]);
+        __builtin_prefetch(&start[q[i].second]);
+      }
+      for (int i = s; i < e; i++) {
+        int l = start[q[i].first], r = start[q[i].second];
+        if (l > r)
+          swap(l, r);
+        int bl = l / b_size, br = r / b_size, k = -1;
+        if (bl + 1 < br) {
+          k = __lg(br - bl - 1);
+          __builtin_prefetch(&dp[k * b_cnt + bl + 1]);
+          __builtin_prefetch(&dp[k * b_cnt + br - (1 << k)]);
+        }
+        __builtin_prefetch(&mask[bl]);
+        __builtin_prefetch(&mask[br]);
+        __builtin_prefetch(&tour[l]);
+        __builtin_prefetch(&tour[r]);
+        c[i - s] = {l, r, k};
+      }
+      for (int i = s; i < e; i++) {
+        auto &[l, r, k] = c[i - s];
+        int bl = l / b_size, br = r / b_size;
+        if (bl == br)
+          l = r = _lca_block(bl, l % b_size, r % b_size);
+        else {
+          l = _lca_block(bl, l % b_size, b_size - 1);
+          r = _lca_block(br, 0, r % b_size);
+          if (k != -1)
+            k = _min_by_depth(dp[k * b_cnt + bl + 1],
+                              dp[k * b_cnt + br - (1 << k)]);
+        }
+        __builtin_prefetch(&depth[tour[l]]);
+        __builtin_prefetch(&depth[tour[r]]);
+      }
+      for (int i = s; i < e; i++) {
+        auto [l, r, k] = c[i - s];
+        int x = _min_by_depth(l, r);
+        ans[i] = tour[k == -1 ? x : _min_by_depth(x, k)];
+      }
     }
-    return tour[ans];
+    return ans;
+  }
+
+  /**
+   * @brief Returns the Euler tour of the tree.
+   *
+   * Every node is listed when it is entered and again after each of its
+   * children is finished, for 2N - 1 entries in total.
+   *
+   * Time Complexity: \f$O(1)\f$
+   */
+  const vector<int> &euler_tour() const { return tour; }
+
+  /**
+   * @brief Returns the Euler tour range of a subtree.
+   *
+   * Time Complexity: \f$O(1)\f$
+   *
+   * @param v Node index.
+   * @return The tour positions [l, r) that cover the subtree of v. Position l
+   * is where v is entered, and the nodes entered in [l, r) are exactly the
+   * subtree of v.
+   */
+  pair<int, int> subtree(int v) const { return {start[v], end[v]}; }
+
+  /**
+   * @brief Computes the distance between two nodes in edges.
+   *
+   * Time Complexity: \f$O(1)\f$
+   *
+   * @param v First node index.
+   * @param u Second node index.
+   * @return The number of edges on the path between v and u.
+   */
+  int distance(int v, int u) const {
+    return depth[v] + depth[u] - 2 * depth[query(v, u)];
+  }
+
+  /**
+   * @brief Finds the k-th ancestor of a node.
+   *
+   * The ancestor is the last node of the target depth that is entered before
+   * v in the Euler tour, found by binary search among the nodes of that depth.
+   * This needs only \f$O(N)\f$ extra memory instead of a binary lifting
+   * table.
+   *
+   * Time Complexity: \f$O(\log N)\f$
+   *
+   * @param v Node index.
+   * @param k Number of edges to climb.
+   * @return The ancestor of v that is k edges above it, or -1 if k exceeds
+   * the depth of v.
+   */
+  int kth_ancestor(int v, int k) const {
+    int d = depth[v] - k;
+    if (k < 0 || d < 0)
+      return -1;
+    auto it = upper_bound(level.begin() + level_start[d],
+                          level.begin() + level_start[d + 1], start[v],
+                          [&](int t, int u) { return t < start[u]; });
+    return *prev(it);
+  }
+
+  /**
+   * @brief Finds the node d edges away from v on the path from v to u.
+   *
+   * Time Complexity: \f$O(\log N)\f$
+   *
+   * @param v Start node index.
+   * @param u End node index.
+   * @param d Number of edges to move towards u.
+   * @return The node at distance d from v on the path to u, or -1 if d
+   * exceeds the length of the path.
+   */
+  int jump(int v, int u, int d) const {
+    int a = query(v, u), dv = depth[v] - depth[a], du = depth[u] - depth[a];
+    if (d < 0 || d > dv + du)
+      return -1;
+    return d <= dv ? kth_ancestor(v, d) : kth_ancestor(u, dv + du - d);
   }
-};
+};
\ No newline at end of file
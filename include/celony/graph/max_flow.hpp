@@ -2,101 +2,310 @@
 using namespace std;
 
 /**
- * @brief Dinic's algorithm for maximum flow.
+ * @brief Algorithms available to max_flow.
+ */
+enum class max_flow_algorithm {
+  dinic,         // Dinic's algorithm, O(V^2 E).
+  dinic_scaling, // Dinic's algorithm with capacity scaling, O(V E log U).
+  hlpp,          // Highest-label push-relabel, O(V^2 sqrt(E)).
+};
+
+/**
+ * @brief Maximum flow with Dinic's algorithm or push-relabel.
  *
  * Computes the maximum flow in a directed graph with given capacities in
- * \f$O(VE^2)\f$ time with \f$O(VE)\f$ space.
+ * \f$O(V^2E)\f$ time with \f$O(V + E)\f$ space.
+ *
+ * Edges are collected by add_edge() and compacted into a flat array grouped by
+ * source vertex (CSR) before the next flow computation, so every adjacency
+ * scan is sequential. Each phase keeps a current-arc pointer per vertex, so
+ * exhausted edges are never scanned twice in a phase.
+ *
+ * With capacity scaling, phases only use edges with remaining capacity of at
+ * least a threshold, which starts at the highest power of two not above the
+ * largest capacity and is halved until 1. This bounds the work by
+ * \f$O(VE \log U)\f$ where U is the largest capacity, which helps on graphs
+ * with large capacities.
+ *
+ * Highest-label push-relabel (HLPP) instead repeatedly discharges the active
+ * vertex with the highest label. Labels are recomputed by a reverse BFS from
+ * the target at the start and after every O(V + E) relabeling work (global
+ * relabeling), and when a label becomes empty every vertex above it is cut off
+ * from the target (gap heuristic). It is usually the fastest choice on dense
+ * graphs. Excess that cannot reach the target is returned to the source by a
+ * second pass, so afterwards `e` holds a valid flow as with Dinic.
  *
  * @tparam F Flow capacity type.
+ * @tparam A Algorithm, see max_flow_algorithm. Capacity scaling requires an
+ * integral F.
  *
  * @see https://codeforces.com/blog/entry/66006 for scaling optimization.
  */
-template <typename F> struct max_flow {
+template <typename F, max_flow_algorithm A = max_flow_algorithm::dinic>
+struct max_flow {
+  static_assert(A != max_flow_algorithm::dinic_scaling || is_integral_v<F>,
+                "capacity scaling requires an integral capacity type");
+
   /**
    * @brief Edge structure for the flow graph.
    *
-   * The original vertex is omitted since the graph is an adjacency list.
+   * The original vertex is omitted since edges are grouped by it.
    */
   struct edge_t {
     int to;  // Destination vertex index.
-    int rev; // Index of the reverse edge in `g[to]`.
+    int rev; // Index of the reverse edge in `e`.
     F cap;   // Remaining capacity of the edge.
   };
-  vector<vector<edge_t>> g; // Adjacency list graph.
+  vector<int> offsets; // Edges leaving v are e[offsets[v]..offsets[v + 1]).
+  vector<edge_t> e;    // Edges of the residual graph, grouped by source.
 
-  /**
-   * @brief Constructs a max flow graph with the given number of vertices.
-   *
-   * @param n Number of vertices in the graph.
-   */
-  max_flow(int n) : g(n) {}
+private:
+  vector<tuple<int, int, F>> pending; // Edges added since the last build.
+  vector<int> lvl, q, it;             // BFS levels, queue and current arcs.
 
-  /**
-   * @brief Adds a directed edge with the given capacity to the flow graph.
-   *
-   * @param a From vertex index.
-   * @param b To vertex index.
-   * @param cap Capacity of the edge.
-   */
-  void add_edge(int a, int b, F cap) {
-    g[a].push_back({b, (int)g[b].size(), cap});
-    g[b].push_back({a, (int)g[a].size() - 1, 0});
+  // Merges pending edges into the CSR arrays, keeping residual capacities.
+  void _build() {
+    if (pending.empty())
+      return;
+    int n = offsets.size() - 1;
+    vector<int> no(n + 1);
+    for (int v = 0; v < n; v++)
+      no[v + 1] = offsets[v + 1] - offsets[v];
+    for (auto &[a, b, cap] : pending)
+      no[a + 1]++, no[b + 1]++;
+    partial_sum(no.begin(), no.end(), no.begin());
+    vector<edge_t> ne(no[n]);
+    vector<int> pos(n);
+    for (int v = 0; v < n; v++) {
+      pos[v] = no[v];
+      for (int i = offsets[v]; i < offsets[v + 1]; i++) {
+        auto [to, rev, cap] = e[i];
+        ne[pos[v]++] = {to, no[to] + rev - offsets[to], cap};
+      }
+    }
+    for (auto &[a, b, cap] : pending) {
+      int i = pos[a]++, j = pos[b]++;
+      ne[i] = {b, j, cap};
+      ne[j] = {a, i, 0};
+    }
+    pending.clear();
+    offsets.swap(no);
+    e.swap(ne);
   }
 
-  /**
-   * @brief Computes the maximum flow from source to target.
-   *
-   * Time Complexity: \f$O(VE^2)\f$.
-   *
-   * @param source Source vertex index.
-   * @param target Target vertex index.
-   * @param initial_flow Initial flow to send (default is infinity).
-   */
-  F flow(int source, int target, F initial_flow = numeric_limits<F>::max()) {
-    int n = g.size();
+  // Runs Dinic phases over edges with capacity at least lim (and positive)
+  // until no augmenting path remains or limit is sent.
+  F _dinic(int source, int target, F lim, F limit) {
+    int n = offsets.size() - 1;
     F ans = 0;
     while (1) {
-      vector<int> lvl(n, -1);
+      fill(lvl.begin(), lvl.end(), -1);
       lvl[source] = 0;
-      queue<int> q{{source}};
-      while (q.size()) {
-        auto v = q.front();
-        q.pop();
-        for (auto &e : g[v]) {
-          if (e.cap > 0 && lvl[e.to] == -1) {
-            lvl[e.to] = lvl[v] + 1;
-            q.push(e.to);
+      q[0] = source;
+      for (int h = 0, t = 1; h < t && lvl[target] == -1; h++) {
+        int v = q[h];
+        for (int i = offsets[v]; i < offsets[v + 1]; i++) {
+          if (e[i].cap > 0 && e[i].cap >= lim && lvl[e[i].to] == -1) {
+            lvl[e[i].to] = lvl[v] + 1;
+            q[t++] = e[i].to;
           }
         }
       }
       if (lvl[target] == -1) {
         break;
       }
+      copy(offsets.begin(), offsets.begin() + n, it.begin());
       auto dfs = [&](auto &&self, int v, F f) -> F {
         if (v == target) {
           return f;
         }
         F ans = 0;
-        for (auto &e : g[v]) {
-          F ff = min(f, e.cap);
-          if (lvl[v] + 1 == lvl[e.to] && ff > 0) {
-            F res = self(self, e.to, ff);
-            e.cap -= res;
-            g[e.to][e.rev].cap += res;
+        for (int &i = it[v]; i < offsets[v + 1]; i++) {
+          auto &[to, rev, cap] = e[i];
+          if (cap > 0 && cap >= lim && lvl[v] + 1 == lvl[to]) {
+            F res = self(self, to, min(f, cap));
+            cap -= res;
+            e[rev].cap += res;
             f -= res;
             ans += res;
+            if (f == 0) {
+              break; // Edge i may still have capacity left.
+            }
           }
         }
-        lvl[v] = -1;
         return ans;
       };
-      F flow = dfs(dfs, source, initial_flow);
+      F flow = dfs(dfs, source, limit);
       if (flow == 0) {
         break;
       }
       ans += flow;
-      initial_flow -= flow;
+      limit -= flow;
     }
     return ans;
   }
+
+  // Highest-label push-relabel. The first pass moves as much of the source's
+  // limit excess as possible to the target, and the second returns what is
+  // left to the source, so that `e` holds a flow rather than a preflow.
+  // Except for its initial excess, the source is an ordinary vertex.
+  F _hlpp(int source, int target, F limit) {
+    int n = offsets.size() - 1, hi, top;
+    long long work;
+    auto &h = lvl;
+    vector<F> ex(n);
+    // Active vertices by label (stacks) and all vertices by label (lists).
+    vector<int> bhead(n), bnext(n), lhead(n), lnext(n), lprev(n);
+    // Moves excess to sink, never activating skip. Vertices with label n
+    // cannot reach sink and are never active.
+    auto run = [&](int sink, int skip) {
+      auto activate = [&](int v) {
+        bnext[v] = bhead[h[v]], bhead[h[v]] = v;
+        hi = max(hi, h[v]);
+      };
+      auto insert = [&](int v) {
+        lprev[v] = -1, lnext[v] = lhead[h[v]];
+        if (lnext[v] != -1)
+          lprev[lnext[v]] = v;
+        lhead[h[v]] = v;
+        top = max(top, h[v]);
+      };
+      auto erase = [&](int v) {
+        (lprev[v] == -1 ? lhead[h[v]] : lnext[lprev[v]]) = lnext[v];
+        if (lnext[v] != -1)
+          lprev[lnext[v]] = lprev[v];
+      };
+      auto global_relabel = [&]() {
+        fill(h.begin(), h.end(), n);
+        fill(bhead.begin(), bhead.end(), -1);
+        fill(lhead.begin(), lhead.end(), -1);
+        hi = top = work = 0;
+        h[sink] = 0;
+        q[0] = sink;
+        for (int i = 0, t = 1; i < t; i++) {
+          int u = q[i];
+          insert(u);
+          if (ex[u] > 0 && u != sink && u != skip)
+            activate(u);
+          for (int j = offsets[u]; j < offsets[u + 1]; j++) {
+            int v = e[j].to;
+            if (h[v] == n && e[e[j].rev].cap > 0)
+              h[v] = h[u] + 1, q[t++] = v;
+          }
+        }
+        copy(offsets.begin(), offsets.begin() + n, it.begin());
+      };
+      auto push = [&](int v, int i) {
+        auto &[to, rev, cap] = e[i];
+        F d = min(ex[v], cap);
+        if (to != sink && to != skip && ex[to] == 0)
+          activate(to);
+        cap -= d;
+        e[rev].cap += d;
+        ex[v] -= d;
+        ex[to] += d;
+      };
+      auto relabel = [&](int v) {
+        int old = h[v];
+        erase(v);
+        if (lhead[old] == -1) {
+          // Gap: no vertex above old can reach sink anymore.
+          for (int k = old; k <= top; k++) {
+            for (int w = lhead[k]; w != -1; w = lnext[w])
+              h[w] = n;
+            lhead[k] = -1;
+          }
+          top = old - 1;
+          h[v] = n;
+          return;
+        }
+        h[v] = n;
+        for (int i = offsets[v]; i < offsets[v + 1]; i++)
+          if (e[i].cap > 0 && h[e[i].to] + 1 < h[v])
+            h[v] = h[e[i].to] + 1, it[v] = i;
+        work += offsets[v + 1] - offsets[v] + 12;
+        if (h[v] < n)
+          insert(v);
+      };
+      global_relabel();
+      while (1) {
+        while (hi >= 0 && bhead[hi] == -1)
+          hi--;
+        if (hi < 0)
+          break;
+        int v = bhead[hi];
+        bhead[hi] = bnext[v];
+        if (h[v] != hi)
+          continue; // Cut off by a gap since it was activated.
+        while (ex[v] > 0 && h[v] < n) {
+          int &i = it[v];
+          if (i == offsets[v + 1]) {
+            relabel(v);
+            continue;
+          }
+          if (e[i].cap > 0 && h[e[i].to] + 1 == h[v])
+            push(v, i);
+          if (ex[v] > 0)
+            i++;
+        }
+        if (work > 4 * n + (long long)e.size())
+          global_relabel();
+      }
+    };
+    ex[source] = limit;
+    run(target, -1);
+    // Vertices still holding excess cannot reach the target, so the second
+    // pass never pushes into the target's side of the graph.
+    run(source, target);
+    return ex[target];
+  }
+
+public:
+  /**
+   * @brief Constructs a max flow graph with the given number of vertices.
+   *
+   * @param n Number of vertices in the graph.
+   */
+  max_flow(int n) : offsets(n + 1), lvl(n), q(n), it(n) {}
+
+  /**
+   * @brief Adds a directed edge with the given capacity to the flow graph.
+   *
+   * Time Complexity: \f$O(1)\f$, the edge is merged into the CSR arrays by
+   * the next flow() in \f$O(V + E)\f$.
+   *
+   * @param a From vertex index.
+   * @param b To vertex index.
+   * @param cap Capacity of the edge.
+   */
+  void add_edge(int a, int b, F cap) { pending.push_back({a, b, cap}); }
+
+  /**
+   * @brief Computes the maximum flow from source to target.
+   *
+   * Time Complexity: \f$O(V^2E)\f$, \f$O(VE \log U)\f$ with capacity
+   * scaling, or \f$O(V^2\sqrt{E})\f$ with push-relabel.
+   *
+   * @param source Source vertex index.
+   * @param target Target vertex index.
+   * @param initial_flow Initial flow to send (default is infinity).
+   */
+  F flow(int source, int target, F initial_flow = numeric_limits<F>::max()) {
+    _build();
+    if constexpr (A == max_flow_algorithm::dinic_scaling) {
+      F mx = 0, ans = 0;
+      for (auto &x : e)
+        mx = max(mx, x.cap);
+      F lim = 1;
+      while (lim <= mx / 2)
+        lim *= 2;
+      for (; mx > 0 && lim > 0; lim /= 2)
+        ans += _dinic(source, target, lim, initial_flow - ans);
+      return ans;
+    } else if constexpr (A == max_flow_algorithm::hlpp) {
+      return _hlpp(source, target, initial_flow);
+    } else {
+      return _dinic(source, target, 0, initial_flow);
+    }
+  }
 };
\ No newline at end of file
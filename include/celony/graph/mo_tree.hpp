@@ -2,6 +2,7 @@
 using namespace std;
 
 #include <celony/graph/lowest_common_ancestor.hpp>
+#include <celony/utility/radix_sort.hpp>
 
 /**
  * @brief Mo's Algorithm for offline path queries on trees.
@@ -13,24 +14,30 @@ using namespace std;
  * The actual performance heavily depends on the heuristic used to order
  * queries. Hilbert curve ordering provides the best practical performance.
  *
- * @tparam R Query answer type.
+ * @tparam Add Callable `void(int)` that adds a node to the path.
+ * @tparam Erase Callable `void(int)` that removes a node from the path.
+ * @tparam F Answer function, called with the additional query arguments.
  * @tparam Args Additional argument types to pass to the answer function.
  *
  * @note Requires a lowest_common_ancestor object to be constructed first.
+ * @note Callbacks are template parameters so they can be inlined into the
+ * pointer-moving loops; see mo_tree_fn for a type-erased alternative.
  * @see https://codeforces.com/blog/entry/61203 for Hilbert curve details.
  */
-template <typename R, typename... Args> class mo_tree {
+template <typename Add, typename Erase, typename F, typename... Args>
+class mo_tree {
+  using R = invoke_result_t<F &, Args &...>;
   vector<pair<int, int>> q;
   vector<tuple<Args...>> f_args;
-  function<void(int)> add, erase;
-  function<R(Args...)> f;
+  Add add;
+  Erase erase;
+  F f;
 
 public:
   /**
    * @brief Constructs a Mo's algorithm solver for tree paths.
    */
-  mo_tree(function<void(int)> add, function<void(int)> remove,
-          function<R(Args...)> f)
+  mo_tree(Add add, Erase erase, F f)
       : add(std::move(add)), erase(std::move(erase)), f(std::move(f)) {}
 
   /**
@@ -44,63 +51,95 @@ public:
    */
   void add_query(int l, int r, const Args &...args) {
     q.push_back({l, r});
-    f_args.push_back(args...);
+    f_args.emplace_back(args...);
   };
 
   /**
    * @brief Solves all tree path queries and returns answers in insertion order.
    *
+   * Each path is mapped to a range of the Euler tour in which exactly the
+   * path nodes, except possibly the LCA, appear an odd number of times. The
+   * LCA of every query is computed once during this mapping.
+   *
    * Time Complexity: \f$O((N + Q)\sqrt{N})\f$ where Q is the number of queries
    *
-   * @param f Heuristic function that assigns comparable values to queries.
-   *          Queries are processed in increasing order of these values.
-   *          For best performance, use Hilbert curve ordering.
+   * @param heuristic Function that assigns comparable values to queries.
+   *                  Queries are processed in increasing order of these
+   *                  values. For best performance, use Hilbert curve ordering.
+   *                  Unsigned integer values are ordered by radix sort,
+   *                  and the ranges and answer arguments are then laid out
+   *                  in processing order.
    * @param lca The LCA data structure for the tree.
    * @return Vector of answers corresponding to each query in the order they
    * were added.
    */
-  template <typename F>
-  vector<R> solve(F &&f, const lowest_common_ancestor &lca) {
+  template <typename H>
+  vector<R> solve(H &&heuristic, const lowest_common_ancestor &lca) {
     int n = lca.depth.size(), m = q.size();
     vector<pair<int, int>> q2(m);
+    vector<int> extra(m, -1); // LCA to add separately, -1 if on the range
     for (int i = 0; i < m; i++) {
       auto [u, v] = q[i];
       if (lca.start[u] > lca.start[v])
         swap(u, v);
-      q2[i] = {lca.query(u, v) == u ? lca.start[u] : lca.end[u], lca.start[v]};
+      int a = lca.query(u, v);
+      q2[i] = {a == u ? lca.start[u] : lca.end[u], lca.start[v]};
+      if (a != u)
+        extra[i] = a;
     }
-    auto h = f(q2);
-    vector<int> ord(m);
-    iota(ord.begin(), ord.end(), 0);
-    sort(ord.begin(), ord.end(), [&](int i, int j) { return h[i] < h[j]; });
-    vector<int> cnt(n);
+    auto ord = sort_order(invoke(std::forward<H>(heuristic), q2));
+    vector<tuple<int, int, int>> qs(m); // [l, r, extra] in processing order
+    vector<tuple<Args...>> as(m);
+    for (int i = 0; i < m; i++) {
+      qs[i] = {q2[ord[i]].first, q2[ord[i]].second, extra[ord[i]]};
+      as[i] = f_args[ord[i]];
+    }
+    // Tour position to the node entered or left there. Only nodes entered by
+    // the tour are mapped; unreachable ones share start == end == 0.
+    vector<int> node(2 * n);
+    for (int i = 0; i < (int)lca.tour.size(); i++)
+      if (int u = lca.tour[i]; lca.start[u] == i)
+        node[i] = node[lca.end[u]] = u;
+    vector<bool> in(n);
     vector<R> ans(m);
-    auto modify = [&](int u, int c) {
-      if (c & 1)
+    auto toggle = [&](int u) {
+      in[u] = !in[u];
+      if (in[u])
         add(u);
       else
         erase(u);
     };
     for (int i = 0, cl = 0, cr = -1; i < m; i++) {
-      auto [l, r] = q2[ord[i]];
-      int u = lca.node[l], v = lca.node[r],
-          a = lca.query(lca.node[l], lca.node[r]);
+      auto [l, r, a] = qs[i];
       while (cr < r)
-        ++cr, modify(lca.node[cr], ++cnt[lca.node[cr]]);
+        toggle(node[++cr]);
       while (l < cl)
-        --cl, modify(lca.node[cl], ++cnt[lca.node[cl]]);
+        toggle(node[--cl]);
       while (r < cr)
-        modify(lca.node[cr], --cnt[lca.node[cr]]), --cr;
+        toggle(node[cr--]);
       while (cl < l)
-        modify(lca.node[cl], --cnt[lca.node[cl]]), ++cl;
-      if (a == u)
-        ans[ord[i]] = f();
+        toggle(node[cl++]);
+      if (a == -1)
+        ans[ord[i]] = apply(f, as[i]);
       else {
-        modify(a, ++cnt[a]);
-        ans[ord[i]] = apply(f, f_args[ord[i]]);
-        modify(a, --cnt[a]);
+        add(a);
+        ans[ord[i]] = apply(f, as[i]);
+        erase(a);
       }
     }
     return ans;
   }
 };
+template <typename Add, typename Erase, typename F>
+mo_tree(Add, Erase, F) -> mo_tree<Add, Erase, F>;
+
+/**
+ * @brief Mo's algorithm tree path solver with type-erased std::function
+ * callbacks.
+ *
+ * @tparam R Query answer type.
+ * @tparam Args Additional argument types passed to answer function.
+ */
+template <typename R, typename... Args>
+using mo_tree_fn = mo_tree<function<void(int)>, function<void(int)>,
+                           function<R(Args...)>, Args...>;
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include <bits/stdc++.h>
+using namespace std;
+
+#include <celony/graph/csr_graph.hpp>
+#include <celony/graph/lowest_common_ancestor.hpp>
+#include <celony/utility/radix_sort.hpp>
+
+/**
+ * @brief Builds the virtual (auxiliary) tree of a subset of vertices.
+ *
+ * The virtual tree contains the given vertices and the lowest common ancestors
+ * of all pairs of them, which are exactly the LCAs of neighbours in Euler tour
+ * order. Each node is connected to its nearest proper ancestor in the tree, so
+ * work per query is proportional to the subset size instead of N.
+ *
+ * Vertices are ordered by their Euler tour entry, with radix sort for large
+ * subsets, and parents are found with a stack of the current root path.
+ *
+ * Time Complexity: \f$O(K)\f$ for K >= 64 vertices, \f$O(K \log K)\f$ below
+ *
+ * @param lca The LCA data structure for the tree.
+ * @param vs Vertices of the subset, duplicates allowed.
+ * @return The nodes of the virtual tree in preorder, with the root first, and
+ * the edges from every node to its children, using indices into that list.
+ * Edge lengths in the original tree are given by lca.distance().
+ */
+pair<vector<int>, csr_graph> virtual_tree(const lowest_common_ancestor &lca,
+                                          const vector<int> &vs) {
+  auto sort_by_start = [&](vector<int> &a) {
+    int k = a.size();
+    if (k < 64) {
+      sort(a.begin(), a.end(), [&](int u, int v) {
+        return lca.subtree(u).first < lca.subtree(v).first;
+      });
+    } else {
+      vector<uint32_t> key(k);
+      for (int i = 0; i < k; i++)
+        key[i] = lca.subtree(a[i]).first;
+      vector<int> ord = radix_order(key), b(k);
+      for (int i = 0; i < k; i++)
+        b[i] = a[ord[i]];
+      a.swap(b);
+    }
+    a.erase(unique(a.begin(), a.end()), a.end());
+  };
+  vector<int> a(vs);
+  sort_by_start(a);
+  for (int i = 0, k = a.size(); i + 1 < k; i++)
+    a.push_back(lca.query(a[i], a[i + 1]));
+  sort_by_start(a);
+  int m = a.size();
+  vector<pair<int, int>> edges;
+  edges.reserve(max(0, m - 1));
+  vector<int> st; // Nodes on the path from the root to the current node.
+  for (int i = 0; i < m; i++) {
+    int s = lca.subtree(a[i]).first;
+    while (!st.empty() && lca.subtree(a[st.back()]).second <= s)
+      st.pop_back();
+    if (!st.empty())
+      edges.push_back({st.back(), i});
+    st.push_back(i);
+  }
+  return {a, csr_graph(m, edges, true)};
+}
\ No newline at end of file
@@ -8,10 +8,17 @@ using namespace std;
  * This ordering has excellent locality properties, making it ideal for
  * reordering queries in Mo's algorithm to minimize pointer movements.
  *
+ * All points are placed on one grid whose order is fixed by the largest
+ * coordinate, so their values are comparable. The curve is walked 4 levels
+ * at a time through a lookup table of the 4-state Hilbert automaton, one
+ * level block for all points before the next, so the inner loop has no
+ * data-dependent branches and independent iterations.
+ *
  * Time Complexity: \f$O(Q \log \max(\text{coordinates}))\f$
  * Space Complexity: \f$O(Q)\f$
  *
- * @param q List of 2D points/queries as (x, y) pairs.
+ * @param q List of 2D points/queries as (x, y) pairs with non-negative
+ *          coordinates.
  * @return Vector of 64-bit integers representing Hilbert curve positions.
  *         Sorting queries by these values optimizes Mo's algorithm.
  *
@@ -19,23 +26,41 @@ using namespace std;
  * @see https://codeforces.com/blog/entry/61203
  */
 vector<uint64_t> hilbert(const vector<pair<int, int>> &q) {
-  int n = q.size();
+  // lut[s << 8 | x << 4 | y] = next state << 8 | 8-bit curve digits, for
+  // state s and 4-bit slices x, y. The state tracks whether the remaining
+  // coordinates are swapped (bit 0) and complemented (bit 1).
+  static const auto lut = [] {
+    array<uint16_t, 1024> lut{};
+    for (int s0 = 0; s0 < 4; s0++)
+      for (int x = 0; x < 16; x++)
+        for (int y = 0; y < 16; y++) {
+          int s = s0, ord = 0;
+          for (int b = 3; b >= 0; b--) {
+            int rx = x >> b & 1, ry = y >> b & 1;
+            if (s & 2)
+              rx ^= 1, ry ^= 1;
+            if (s & 1)
+              swap(rx, ry);
+            ord = ord << 2 | (rx ? ry ? 2 : 1 : ry ? 3 : 0);
+            if (!rx)
+              s ^= 1 | ry << 1;
+          }
+          lut[s0 << 8 | x << 4 | y] = s << 8 | ord;
+        }
+    return lut;
+  }();
+  int n = q.size(), mx = 0;
+  for (auto [x, y] : q)
+    mx |= x | y;
+  int l = (__lg(mx | 1) >> 2) + 1; // number of 4-level blocks
   vector<uint64_t> ans(n);
-  for (int i = 0; i < n; i++) {
-    auto [x, y] = q[i];
-    const uint64_t l = __lg(max(x, y) * 2 + 1) | 1;
-    const uint64_t mx = (1ull << l) - 1;
-    uint64_t ord = 0;
-    for (uint64_t s = 1ull << (l - 1); s; s >>= 1) {
-      bool rx = x & s, ry = y & s;
-      ord = (ord << 2) | (rx ? ry ? 2 : 1 : ry ? 3 : 0);
-      if (!rx) {
-        if (ry)
-          x ^= mx, y ^= mx;
-        swap(x, y);
-      }
+  vector<uint16_t> s(n);
+  for (int b = (l - 1) * 4; b >= 0; b -= 4)
+    for (int i = 0; i < n; i++) {
+      auto [x, y] = q[i];
+      int e = lut[s[i] << 8 | (x >> b & 15) << 4 | (y >> b & 15)];
+      ans[i] = ans[i] << 8 | (e & 255);
+      s[i] = e >> 8;
     }
-    ans[i] = ord;
-  }
   return ans;
-}
+}
\ No newline at end of file
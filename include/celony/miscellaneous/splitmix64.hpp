@@ -0,0 +1,36 @@
+#pragma once
+#include <bits/stdc++.h>
+using namespace std;
+
+/**
+ * @brief SplitMix64 pseudo-random number generator.
+ *
+ * A tiny, fast generator with a single 64-bit state word that passes BigCrush.
+ * Unlike rand(), every instance owns its state, so it needs no locking and is
+ * reproducible per instance when seeded explicitly. Satisfies the
+ * UniformRandomBitGenerator requirements, so it plugs into <random>
+ * distributions and shuffle.
+ *
+ * Time Complexity: \f$O(1)\f$ per number
+ *
+ * @note Defaults to a time-based seed.
+ * @see https://prng.di.unimi.it/splitmix64.c
+ */
+struct splitmix64 {
+  using result_type = uint64_t;
+  uint64_t x;
+
+  splitmix64(uint64_t seed =
+                 chrono::steady_clock::now().time_since_epoch().count())
+      : x(seed) {}
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return numeric_limits<uint64_t>::max(); }
+
+  result_type operator()() {
+    uint64_t z = x += 0x9e3779b97f4a7c15;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+  }
+};
\ No newline at end of file
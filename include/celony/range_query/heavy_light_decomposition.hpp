@@ -1,7 +1,9 @@
 #include <bits/stdc++.h>
 using namespace std;
 
+#include <celony/graph/csr_graph.hpp>
 #include <celony/range_query/segment_tree.hpp>
+#include <celony/range_query/segment_tree_lazy.hpp>
 
 /**
  * @brief Heavy-Light Decomposition for path queries on trees.
@@ -10,17 +12,91 @@ using namespace std;
  * updates to be answered using a segment tree. Each root-to-node path
  * crosses at most \f$O(\log N)\f$ light edges, enabling efficient queries.
  *
+ * Nodes are numbered so that every heavy chain and every subtree occupies a
+ * contiguous range, which is stored in the backing range structure.
+ *
  * @tparam T Value type.
  * @tparam Combine Binary associative operation for combining path values.
+ * @tparam Seg Backing range structure over the numbering, segment_tree for
+ * point updates or segment_tree_lazy for path and subtree updates.
+ * @tparam Commutative Whether Combine is commutative. If false, a second
+ * structure over the mirrored numbering is kept so path queries combine
+ * values in order from the first node to the second, at twice the update
+ * cost.
  *
  * @note Each path crosses at most log N chains.
  * @note For edge-weighted trees, store edge weights at the deeper endpoint.
  */
-template <typename T, typename Combine> class heavy_light_decomposition {
-  vector<int> top, depth, id, par;
-  segment_tree<T, Combine> seg;
+template <typename T, typename Combine,
+          typename Seg = segment_tree<T, Combine>, bool Commutative = true>
+class heavy_light_decomposition {
+  vector<int> top, depth, id, par, size;
+  Seg seg;
+  optional<Seg> rseg; // mirrored numbering, only for non-commutative Combine
   Combine combine;
-  void _init(const vector<vector<int>> &g, int root) {}
+
+  // Both passes use explicit stacks so deep trees cannot overflow the call
+  // stack. Each chain is numbered top to bottom before the light subtrees
+  // hanging off it, which keeps every chain and subtree contiguous.
+  template <typename G>
+  vector<T> _init(const G &g, const vector<T> &v, int root) {
+    int n = g.size();
+    top.resize(n);
+    depth.resize(n);
+    id.resize(n);
+    par.resize(n);
+    size.assign(n, 1);
+    vector<int> ord(n), heavy(n, -1);
+    ord[0] = par[root] = root;
+    for (int i = 0, j = 1; i < n; i++) {
+      int u = ord[i];
+      for (int v : g[u])
+        if (v != par[u]) {
+          par[v] = u;
+          depth[v] = depth[u] + 1;
+          ord[j++] = v;
+        }
+    }
+    for (int i = n - 1; i > 0; i--) {
+      int u = ord[i], p = par[u];
+      size[p] += size[u];
+      if (heavy[p] == -1 || size[u] > size[heavy[p]])
+        heavy[p] = u;
+    }
+    // ord is no longer needed and serves as the stack of chain tops.
+    ord.assign(1, root);
+    for (int time = 0; !ord.empty();) {
+      int t = ord.back();
+      ord.pop_back();
+      for (int u = t; u != -1; u = heavy[u]) {
+        top[u] = t;
+        id[u] = time++;
+        for (int v : g[u])
+          if (v != par[u] && v != heavy[u])
+            ord.push_back(v);
+      }
+    }
+    return _reorder(v, false);
+  }
+  vector<T> _reorder(const vector<T> &v, bool mirror) const {
+    int n = v.size();
+    vector<T> ans(v);
+    for (int i = 0; i < n; i++)
+      ans[mirror ? n - 1 - id[i] : id[i]] = v[i];
+    return ans;
+  }
+
+  // Calls f(l, r) for the id ranges [l, r) covering the path from a to b.
+  template <typename F> void _path(int a, int b, F &&f) {
+    for (; top[a] != top[b]; a = par[top[a]]) {
+      if (depth[top[a]] < depth[top[b]])
+        swap(a, b);
+      f(id[top[a]], id[a] + 1);
+    }
+    if (depth[a] > depth[b])
+      swap(a, b);
+    f(id[a], id[b] + 1);
+  }
 
 public:
   /**
@@ -28,13 +104,14 @@ public:
    *
    * Time Complexity: \f$O(N)\f$
    *
-   * @param g Tree adjacency list.
+   * @param g Tree adjacency list, vector<vector<int>> or csr_graph.
    * @param v Initial value for all nodes.
    * @param combine Binary associative operation for path queries.
    * @param root Root of the tree (default 0).
    */
-  heavy_light_decomposition(const vector<vector<int>> &g, const T &v,
-                            const Combine &combine, int root = 0)
+  template <typename G>
+  heavy_light_decomposition(const G &g, const T &v, const Combine &combine,
+                            int root = 0)
       : heavy_light_decomposition(g, vector<T>(g.size(), v), v, combine, root) {
   }
 
@@ -43,50 +120,43 @@ public:
    *
    * Time Complexity: \f$O(N)\f$
    *
-   * @param g Tree adjacency list.
+   * @param g Tree adjacency list, vector<vector<int>> or csr_graph.
    * @param v Initial values for nodes.
    * @param v0 Default value for queries.
    * @param combine Binary associative operation for path queries.
    * @param root Root of the tree (default 0).
    */
-  heavy_light_decomposition(const vector<vector<int>> &g, const vector<T> &v,
-                            const T &v0, const Combine &combine, int root = 0)
-      : seg(g.size(), v0, combine), combine(combine) {
-    int n = g.size();
-    vector<int> size(n, 1);
-    top.resize(n);
-    depth.resize(n);
-    id.resize(n);
-    par.resize(n);
-    auto dfs = [&](auto &&self, int u, int p) -> int {
-      par[u] = p;
-      depth[u] = depth[p] + 1;
-      for (int v : g[u])
-        if (v != p)
-          size[u] += self(self, v, u);
-      return size[u];
-    };
-    dfs(dfs, root, root);
-    auto dfs2 = [&, time = 0](auto &&self, int u, int p,
-                              int t) mutable -> void {
-      top[u] = t;
-      id[u] = time++;
-      int hvy_v = -1, hvy_s = -1;
-      for (int v : g[u])
-        if (v != p && size[v] > hvy_s) {
-          hvy_v = v;
-          hvy_s = size[v];
-        }
-      if (hvy_v == -1)
-        return;
-      self(self, hvy_v, u, t);
-      for (int v : g[u])
-        if (v != p && v != hvy_v)
-          self(self, v, u, v);
-    };
-    dfs2(dfs2, root, root, root);
-    for (int i = 0; i < n; i++)
-      seg.set(id[i], v[i]);
+  template <typename G>
+  heavy_light_decomposition(const G &g, const vector<T> &v, const T &v0,
+                            const Combine &combine, int root = 0)
+      : seg(_init(g, v, root), v0, combine), combine(combine) {
+    if constexpr (!Commutative)
+      rseg.emplace(_reorder(v, true), v0, combine);
+  }
+
+  /**
+   * @brief Constructs HLD backed by a lazy segment tree, enabling path and
+   * subtree updates.
+   *
+   * Time Complexity: \f$O(N)\f$
+   *
+   * @param g Tree adjacency list, vector<vector<int>> or csr_graph.
+   * @param v Initial values for nodes.
+   * @param v0 Default value for queries.
+   * @param u0 Default lazy tag value.
+   * @param apply Function to apply lazy tag to a node: (T, U, size) -> T
+   * @param push Function to combine lazy tags: (U, U, size) -> U
+   * @param combine Binary associative operation for path queries.
+   * @param root Root of the tree (default 0).
+   */
+  template <typename G, typename U, typename Apply, typename Push>
+  heavy_light_decomposition(const G &g, const vector<T> &v, const T &v0,
+                            const U &u0, const Apply &apply, const Push &push,
+                            const Combine &combine, int root = 0)
+      : seg(_init(g, v, root), v0, u0, apply, push, combine),
+        combine(combine) {
+    if constexpr (!Commutative)
+      rseg.emplace(_reorder(v, true), v0, u0, apply, push, combine);
   }
 
   /**
@@ -97,7 +167,11 @@ public:
    * @param a Node index.
    * @param v Value to combine with the current node value.
    */
-  void update(int a, const T &v) { seg.update(id[a], v); }
+  void update(int a, const T &v) {
+    seg.update(id[a], v);
+    if constexpr (!Commutative)
+      rseg->update(id.size() - 1 - id[a], v);
+  }
 
   /**
    * @brief Sets the value at a node, replacing the current value.
@@ -107,7 +181,11 @@ public:
    * @param a Node index.
    * @param v New value.
    */
-  void set(int a, const T &v) { seg.set(id[a], v); }
+  void set(int a, const T &v) {
+    seg.set(id[a], v);
+    if constexpr (!Commutative)
+      rseg->set(id.size() - 1 - id[a], v);
+  }
 
   /**
    * @brief Queries the path between nodes a and b using the combine operation.
@@ -116,20 +194,85 @@ public:
    *
    * @param a First node index.
    * @param b Second node index.
-   * @return The combined result of all node values on the path from a to b.
+   * @return The combined result of all node values on the path from a to b,
+   * in path order if Commutative is false.
    */
   T query(int a, int b) {
     T ans = seg.identity();
-    for (; top[a] != top[b]; a = par[top[a]]) {
-      if (depth[top[a]] < depth[top[b]])
-        swap(a, b);
-      auto res = seg.query(id[top[a]], id[a] + 1);
-      ans = combine(ans, res);
+    if constexpr (Commutative) {
+      _path(a, b, [&](int l, int r) { ans = combine(ans, seg.query(l, r)); });
+    } else {
+      // Climbing from a reads chains upwards (mirrored numbering), while the
+      // chains towards b are read downwards and prepended.
+      int n = id.size();
+      T down = ans;
+      for (; top[a] != top[b];) {
+        if (depth[top[a]] >= depth[top[b]]) {
+          ans = combine(ans, rseg->query(n - 1 - id[a], n - id[top[a]]));
+          a = par[top[a]];
+        } else {
+          down = combine(seg.query(id[top[b]], id[b] + 1), down);
+          b = par[top[b]];
+        }
+      }
+      if (depth[a] >= depth[b])
+        ans = combine(ans, rseg->query(n - 1 - id[a], n - id[b]));
+      else
+        down = combine(seg.query(id[a], id[b] + 1), down);
+      ans = combine(ans, down);
     }
-    if (depth[a] > depth[b])
-      swap(a, b);
-    auto res = seg.query(id[a], id[b] + 1);
-    ans = combine(ans, res);
     return ans;
   }
+
+  /**
+   * @brief Applies a lazy update to every node on the path between a and b.
+   *
+   * Time Complexity: \f$O(\log^2 N)\f$
+   *
+   * @param a First node index.
+   * @param b Second node index.
+   * @param u Update value to apply.
+   *
+   * @note Requires a lazy backing structure such as segment_tree_lazy.
+   */
+  template <typename U> void update_path(int a, int b, const U &u) {
+    _path(a, b, [&](int l, int r) {
+      seg.update(l, r, u);
+      if constexpr (!Commutative)
+        rseg->update(id.size() - r, id.size() - l, u);
+    });
+  }
+
+  /**
+   * @brief Queries the subtree of a node using the combine operation.
+   *
+   * Time Complexity: \f$O(\log N)\f$
+   *
+   * @param a Node index.
+   * @return The combined result of all node values in the subtree of a.
+   */
+  T query_subtree(int a) { return seg.query(id[a], id[a] + size[a]); }
+
+  /**
+   * @brief Applies a lazy update to every node in the subtree of a.
+   *
+   * Time Complexity: \f$O(\log N)\f$
+   *
+   * @param a Node index.
+   * @param u Update value to apply.
+   *
+   * @note Requires a lazy backing structure such as segment_tree_lazy.
+   */
+  template <typename U> void update_subtree(int a, const U &u) {
+    seg.update(id[a], id[a] + size[a], u);
+    if constexpr (!Commutative)
+      rseg->update(id.size() - id[a] - size[a], id.size() - id[a], u);
+  }
 };
+template <typename G, typename T, typename U, typename Apply, typename Push,
+          typename Combine>
+heavy_light_decomposition(const G &, const vector<T> &, const T &, const U &,
+                          const Apply &, const Push &, const Combine &,
+                          int = 0)
+    -> heavy_light_decomposition<
+        T, Combine, segment_tree_lazy<T, U, Apply, Push, Combine>>;
\ No newline at end of file
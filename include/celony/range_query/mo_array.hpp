@@ -1,6 +1,8 @@
 #include <bits/stdc++.h>
 using namespace std;
 
+#include <celony/utility/radix_sort.hpp>
+
 /**
  * @brief Mo's Algorithm for offline range queries on arrays.
  *
@@ -12,26 +14,34 @@ using namespace std;
  * Hilbert curve ordering typically provides 2-3x speedup over simpler
  * heuristics.
  *
- * @tparam R Query answer type.
+ * @tparam Add Callable `void(int)` that adds an index to the window.
+ * @tparam Erase Callable `void(int)` that removes an index from the window.
+ * @tparam F Answer function, called with the additional query arguments.
  * @tparam Args Additional argument types passed to answer function.
  *
  * @note Queries must be answered offline (all queries known in advance).
  * @note Best for problems where incremental updates are \f$O(1)\f$ or \f$O(\log
  * N)\f$.
+ * @note Callbacks are template parameters so they can be inlined into the
+ * pointer-moving loops; see mo_array_fn for a type-erased alternative.
  * @see https://codeforces.com/blog/entry/61203 for Hilbert curve details.
  */
-template <typename R, typename... Args> class mo_array {
+template <typename Add, typename Erase, typename F, typename... Args>
+class mo_array {
+  using R = invoke_result_t<F &, Args &...>;
   vector<pair<int, int>> q;
+  vector<int> qt; // number of point updates preceding each query
   vector<tuple<Args...>> f_args;
-  function<void(int)> add, erase;
-  function<R(Args...)> f;
+  int updates = 0;
+  Add add;
+  Erase erase;
+  F f;
 
 public:
   /**
    * @brief Constructs a Mo's algorithm solver.
    */
-  mo_array(function<void(int)> add, function<void(int)> erase,
-           function<R(Args...)> f)
+  mo_array(Add add, Erase erase, F f)
       : add(std::move(add)), erase(std::move(erase)), f(std::move(f)) {}
 
   /**
@@ -45,9 +55,23 @@ public:
    */
   void query(int l, int r, const Args &...args) {
     q.push_back({l, r});
+    qt.push_back(updates);
     f_args.emplace_back(args...);
   };
 
+  /**
+   * @brief Records a point update between the queries added so far and the
+   * ones added afterwards.
+   *
+   * Only the timestamp is stored; the caller keeps the update itself and
+   * performs it in the callbacks given to solve_updates().
+   *
+   * Time Complexity: \f$O(1)\f$
+   *
+   * @return Index of the update, as later passed to the update callbacks.
+   */
+  int update() { return updates++; }
+
   /**
    * @brief Solves all queries and returns answers in insertion order.
    *
@@ -55,28 +79,260 @@ public:
    *
    * @param heuristic Function that assigns a comparable value to each query.
    *                  Queries are processed in increasing order of these values.
+   *                  Unsigned integer values are ordered by radix sort,
+   *                  and the ranges and answer arguments are then laid out
+   *                  in processing order.
    * @return Vector of answers corresponding to each query in the order they
    * were added.
    */
   template <typename H> auto solve(H &&heuristic) {
     int m = q.size();
-    auto h = invoke(std::forward<H>(heuristic), q);
+    auto ord = sort_order(invoke(std::forward<H>(heuristic), q));
+    vector<pair<int, int>> qs(m);
+    vector<tuple<Args...>> as(m);
+    for (int i = 0; i < m; i++)
+      qs[i] = q[ord[i]], as[i] = f_args[ord[i]];
+    int cl = 0, cr = -1;
+    vector<R> ans(m);
+    for (int i = 0; i < m; i++) {
+      auto [l, r] = qs[i];
+      while (cr < r)
+        add(++cr);
+      while (l < cl)
+        add(--cl);
+      while (r < cr)
+        erase(cr--);
+      while (cl < l)
+        erase(cl++);
+      ans[ord[i]] = apply(f, as[i]);
+    }
+    return ans;
+  }
+
+  /**
+   * @brief Solves all queries interleaved with point updates (Mo's algorithm
+   * with modifications) and returns answers in insertion order.
+   *
+   * Queries are sorted by (left block, right block, time) with blocks of size
+   * \f$(N^2 U / Q)^{1/3}\f$, and the time pointer is moved by applying or
+   * undoing updates on the current window.
+   *
+   * Time Complexity: \f$O(N^{2/3} U^{1/3} Q^{2/3} + N + Q \log Q)\f$ where U
+   * is the number of updates
+   *
+   * @param apply_update Callable `void(int j, int l, int r)` that performs
+   *                     update j while the window is [l, r] (empty if l > r).
+   * @param undo_update Callable `void(int j, int l, int r)` that reverts
+   *                    update j while the window is [l, r].
+   * @return Vector of answers corresponding to each query in the order they
+   * were added.
+   */
+  template <typename Apply, typename Undo>
+  auto solve_updates(Apply &&apply_update, Undo &&undo_update) {
+    int m = q.size(), n = 1;
+    for (auto [l, r] : q)
+      n = max(n, r + 1);
+    int b = max(1, (int)cbrt(1.0 * n * n * max(updates, 1) / max(m, 1)));
     vector<int> ord(m);
     iota(ord.begin(), ord.end(), 0);
-    sort(ord.begin(), ord.end(), [&](int i, int j) { return h[i] < h[j]; });
-    int cl = 0, cr = -1;
+    auto key = [&](int i) {
+      int lb = q[i].first / b, rb = q[i].second / b;
+      return tuple(lb, lb & 1 ? -rb : rb, rb & 1 ? -qt[i] : qt[i]);
+    };
+    sort(ord.begin(), ord.end(), [&](int i, int j) { return key(i) < key(j); });
+    int cl = 0, cr = -1, ct = 0;
     vector<R> ans(m);
     for (int i = 0; i < m; i++) {
-      while (cr < q[ord[i]].second)
+      auto [l, r] = q[ord[i]];
+      while (cr < r)
         add(++cr);
-      while (q[ord[i]].first < cl)
+      while (l < cl)
         add(--cl);
-      while (q[ord[i]].second < cr)
+      while (r < cr)
         erase(cr--);
-      while (cl < q[ord[i]].first)
+      while (cl < l)
         erase(cl++);
+      while (ct < qt[ord[i]])
+        apply_update(ct++, cl, cr);
+      while (qt[ord[i]] < ct)
+        undo_update(--ct, cl, cr);
+      ans[ord[i]] = apply(f, f_args[ord[i]]);
+    }
+    return ans;
+  }
+
+  /**
+   * @brief Solves all queries using only additions (rollback Mo's algorithm)
+   * and returns answers in insertion order.
+   *
+   * Queries are grouped by the block of their left boundary. Within a block
+   * the right pointer only grows from the block end, while the part left of
+   * the block end is added per query and discarded by a rollback. Queries
+   * that fit inside one block are answered by direct additions. The erase
+   * callback is never called, so it may be any placeholder (e.g. nullptr).
+   *
+   * Time Complexity: \f$O(N\sqrt{Q} + Q \log Q)\f$ add calls and sorting
+   *
+   * @param snapshot Callable `void()` that pushes a restore point of the
+   *                 current state. At most two restore points are live.
+   * @param rollback Callable `void()` that restores the most recent restore
+   *                 point and discards it.
+   * @return Vector of answers corresponding to each query in the order they
+   * were added.
+   */
+  template <typename Snapshot, typename Rollback>
+  auto solve_rollback(Snapshot &&snapshot, Rollback &&rollback) {
+    int m = q.size(), n = 1;
+    for (auto [l, r] : q)
+      n = max(n, r + 1);
+    int b = max(1, (int)(n / sqrt(max(m, 1))));
+    vector<int> ord(m);
+    iota(ord.begin(), ord.end(), 0);
+    sort(ord.begin(), ord.end(), [&](int i, int j) {
+      return pair(q[i].first / b, q[i].second) <
+             pair(q[j].first / b, q[j].second);
+    });
+    vector<R> ans(m);
+    for (int i = 0, cr = -1, blk = -1, end = -1; i < m; i++) {
+      auto [l, r] = q[ord[i]];
+      if (l / b != blk) {
+        if (blk != -1)
+          rollback();
+        snapshot();
+        blk = l / b, end = cr = (blk + 1) * b - 1;
+      }
+      if (r <= end) {
+        snapshot();
+        for (int j = l; j <= r; j++)
+          add(j);
+      } else {
+        while (cr < r)
+          add(++cr);
+        snapshot();
+        for (int j = end; j >= l; j--)
+          add(j);
+      }
       ans[ord[i]] = apply(f, f_args[ord[i]]);
+      rollback();
     }
+    if (m)
+      rollback();
     return ans;
   }
 };
+template <typename Add, typename Erase, typename F>
+mo_array(Add, Erase, F) -> mo_array<Add, Erase, F>;
+
+/**
+ * @brief Mo's algorithm solver with type-erased std::function callbacks.
+ *
+ * @tparam R Query answer type.
+ * @tparam Args Additional argument types passed to answer function.
+ */
+template <typename R, typename... Args>
+using mo_array_fn = mo_array<function<void(int)>, function<void(int)>,
+                             function<R(Args...)>, Args...>;
+
+/**
+ * @brief Mo's Algorithm for offline range queries, run on multiple threads.
+ *
+ * Queries are sorted by the heuristic and cut into contiguous chunks, one per
+ * thread. Every chunk starts from its own copy of the initial state and an
+ * empty window, which costs at most \f$O(N)\f$ extra pointer moves per thread
+ * in exchange for near-linear scaling with the number of cores.
+ *
+ * @tparam State Window state with members `void add(int)`, `void erase(int)`
+ * and `answer(const Args &...)`. It must be copyable; the copy passed to the
+ * constructor is the state of an empty window.
+ * @tparam Args Additional argument types passed to `State::answer`.
+ *
+ * @note Each thread only touches its own State copy, so the members must not
+ * share mutable data through references or pointers.
+ * @see mo_array for the single-threaded solver.
+ */
+template <typename State, typename... Args> class mo_array_parallel {
+  using R = decltype(declval<State &>().answer(declval<Args &>()...));
+  vector<pair<int, int>> q;
+  vector<tuple<Args...>> f_args;
+  State state;
+  int threads;
+
+public:
+  /**
+   * @brief Constructs a parallel Mo's algorithm solver.
+   *
+   * @param state State of an empty window, copied into every thread.
+   * @param threads Number of worker threads (default is the hardware
+   * concurrency).
+   */
+  mo_array_parallel(const State &state,
+                    int threads = max(1u, thread::hardware_concurrency()))
+      : state(state), threads(threads) {}
+
+  /**
+   * @brief Adds a range query to be solved offline.
+   *
+   * Time Complexity: \f$O(1)\f$
+   *
+   * @param l Left boundary (inclusive).
+   * @param r Right boundary (inclusive).
+   * @param args Additional arguments to pass to the answer function.
+   */
+  void query(int l, int r, const Args &...args) {
+    q.push_back({l, r});
+    f_args.emplace_back(args...);
+  };
+
+  /**
+   * @brief Solves all queries and returns answers in insertion order.
+   *
+   * Time Complexity: \f$O((N + Q)\sqrt{N} / T + NT)\f$ wall time where T is
+   * the number of threads
+   *
+   * @param heuristic Function that assigns a comparable value to each query.
+   *                  Queries are processed in increasing order of these values.
+   *                  Unsigned integer values are ordered by radix sort,
+   *                  and the ranges and answer arguments are then laid out
+   *                  in processing order.
+   * @return Vector of answers corresponding to each query in the order they
+   * were added.
+   */
+  template <typename H> auto solve(H &&heuristic) {
+    int m = q.size(), k = max(1, min(threads, m));
+    auto ord = sort_order(invoke(std::forward<H>(heuristic), q));
+    vector<pair<int, int>> qs(m);
+    vector<tuple<Args...>> as(m);
+    for (int i = 0; i < m; i++)
+      qs[i] = q[ord[i]], as[i] = f_args[ord[i]];
+    vector<vector<R>> part(k);
+    auto run = [&](int t) {
+      int lo = 1LL * m * t / k, hi = 1LL * m * (t + 1) / k;
+      State s = state;
+      part[t].reserve(hi - lo);
+      for (int i = lo, cl = 0, cr = -1; i < hi; i++) {
+        auto [l, r] = qs[i];
+        while (cr < r)
+          s.add(++cr);
+        while (l < cl)
+          s.add(--cl);
+        while (r < cr)
+          s.erase(cr--);
+        while (cl < l)
+          s.erase(cl++);
+        part[t].push_back(apply(
+            [&](auto &...args) { return s.answer(args...); }, as[i]));
+      }
+    };
+    vector<thread> pool;
+    for (int t = 1; t < k; t++)
+      pool.emplace_back(run, t);
+    run(0);
+    for (auto &th : pool)
+      th.join();
+    vector<R> ans(m);
+    for (int t = 0, i = 0; t < k; t++)
+      for (auto &v : part[t])
+        ans[ord[i++]] = std::move(v);
+    return ans;
+  }
+};
\ No newline at end of file
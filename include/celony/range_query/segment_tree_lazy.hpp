@@ -1,3 +1,4 @@
+#pragma once
 #include <bits/stdc++.h>
 using namespace std;
 
@@ -51,7 +52,9 @@ class segment_tree_lazy {
     }
   }
   void _compute(int i, int k) {
-    t[i] = f[i] ? apply(t[i], u[i], k) : combine(t[i << 1], t[i << 1 | 1]);
+    t[i] = combine(t[i << 1], t[i << 1 | 1]);
+    if (f[i])
+      t[i] = apply(t[i], u[i], k);
   }
 
 public:
@@ -72,7 +75,7 @@ public:
                     const Combine &combine)
       : apply(apply), push(push), combine(combine) {
     n0 = v.size();
-    int n2 = 1 << (__lg(n0) + int((n0 & (n0 - 1)) > 0)); // lowest pow2 >= n
+    int n2 = max(2, 1 << (__lg(n0) + int((n0 & (n0 - 1)) > 0))); // pow2 >= n
     t.resize(2 * n2, v0);
     u.resize(n2, u0);
     f.resize(n2);
@@ -106,7 +109,7 @@ public:
     _push(r - 1);
     int k = 1, n = u.size(), cl = 0, cr = 0;
     for (l += n, r += n; l < r; l >>= 1, r >>= 1, k <<= 1) {
-      if (cl)
+      if (cl && l > 1) // node 0 holds the query identity
         _compute(l - 1, k);
       if (cr)
         _compute(r, k);
@@ -120,7 +123,7 @@ public:
       }
     }
     for (--l; r > 0; l >>= 1, r >>= 1, k <<= 1) {
-      if (cl)
+      if (cl && l > 0)
         _compute(l, k);
       if (cr && (!cl || l != r))
         _compute(r, k);
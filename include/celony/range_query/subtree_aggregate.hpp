@@ -0,0 +1,144 @@
+#include <bits/stdc++.h>
+using namespace std;
+
+#include <celony/graph/lowest_common_ancestor.hpp>
+#include <celony/range_query/segment_tree.hpp>
+#include <celony/range_query/segment_tree_lazy.hpp>
+
+/**
+ * @brief Subtree queries and updates on a static rooted tree.
+ *
+ * Numbers the nodes in preorder, taken from the Euler tour of an existing
+ * lowest_common_ancestor, so every subtree occupies a contiguous range that is
+ * stored in the backing range structure. No additional DFS is needed.
+ *
+ * @tparam T Value type.
+ * @tparam Combine Binary associative operation for combining subtree values.
+ * @tparam Seg Backing range structure over the numbering, segment_tree for
+ * point updates or segment_tree_lazy for subtree updates.
+ *
+ * @note Nodes not reachable from the root of the LCA structure are treated as
+ * isolated.
+ */
+template <typename T, typename Combine,
+          typename Seg = segment_tree<T, Combine>>
+class subtree_aggregate {
+  vector<int> id, size;
+  Seg seg;
+
+  vector<T> _init(const lowest_common_ancestor &lca, const vector<T> &v) {
+    int n = v.size(), time = 0;
+    const auto &tour = lca.euler_tour();
+    id.assign(n, -1);
+    size.assign(n, 1);
+    for (int i = 0; i < (int)tour.size(); i++) {
+      auto [l, r] = lca.subtree(tour[i]);
+      if (l == i) {
+        id[tour[i]] = time++;
+        size[tour[i]] = (r - l + 1) / 2; // 2 * size - 1 tour entries
+      }
+    }
+    vector<T> ans(v);
+    for (int i = 0; i < n; i++) {
+      if (id[i] == -1)
+        id[i] = time++;
+      ans[id[i]] = v[i];
+    }
+    return ans;
+  }
+
+public:
+  /**
+   * @brief Constructs the structure from the tree of an LCA structure.
+   *
+   * Time Complexity: \f$O(N)\f$
+   *
+   * @param lca LCA structure of the tree, only used during construction.
+   * @param v Initial values for nodes.
+   * @param v0 Default value for queries.
+   * @param combine Binary associative operation for subtree queries.
+   */
+  subtree_aggregate(const lowest_common_ancestor &lca, const vector<T> &v,
+                    const T &v0, const Combine &combine)
+      : seg(_init(lca, v), v0, combine) {}
+
+  /**
+   * @brief Constructs the structure backed by a lazy segment tree, enabling
+   * subtree updates.
+   *
+   * Time Complexity: \f$O(N)\f$
+   *
+   * @param lca LCA structure of the tree, only used during construction.
+   * @param v Initial values for nodes.
+   * @param v0 Default value for queries.
+   * @param u0 Default lazy tag value.
+   * @param apply Function to apply lazy tag to a node: (T, U, size) -> T
+   * @param push Function to combine lazy tags: (U, U, size) -> U
+   * @param combine Binary associative operation for subtree queries.
+   */
+  template <typename U, typename Apply, typename Push>
+  subtree_aggregate(const lowest_common_ancestor &lca, const vector<T> &v,
+                    const T &v0, const U &u0, const Apply &apply,
+                    const Push &push, const Combine &combine)
+      : seg(_init(lca, v), v0, u0, apply, push, combine) {}
+
+  /**
+   * @brief Updates the value at a node using the combine operation.
+   *
+   * Time Complexity: \f$O(\log N)\f$
+   *
+   * @param a Node index.
+   * @param v Value to combine with the current node value.
+   */
+  void update(int a, const T &v) { seg.update(id[a], v); }
+
+  /**
+   * @brief Sets the value at a node, replacing the current value.
+   *
+   * Time Complexity: \f$O(\log N)\f$
+   *
+   * @param a Node index.
+   * @param v New value.
+   */
+  void set(int a, const T &v) { seg.set(id[a], v); }
+
+  /**
+   * @brief Queries the value at a node.
+   *
+   * Time Complexity: \f$O(\log N)\f$
+   *
+   * @param a Node index.
+   * @return The current value of a.
+   */
+  T query(int a) { return seg.query(id[a], id[a] + 1); }
+
+  /**
+   * @brief Queries the subtree of a node using the combine operation.
+   *
+   * Time Complexity: \f$O(\log N)\f$
+   *
+   * @param a Node index.
+   * @return The combined result of all node values in the subtree of a.
+   */
+  T query_subtree(int a) { return seg.query(id[a], id[a] + size[a]); }
+
+  /**
+   * @brief Applies a lazy update to every node in the subtree of a.
+   *
+   * Time Complexity: \f$O(\log N)\f$
+   *
+   * @param a Node index.
+   * @param u Update value to apply.
+   *
+   * @note Requires a lazy backing structure such as segment_tree_lazy.
+   */
+  template <typename U> void update_subtree(int a, const U &u) {
+    seg.update(id[a], id[a] + size[a], u);
+  }
+};
+template <typename T, typename U, typename Apply, typename Push,
+          typename Combine>
+subtree_aggregate(const lowest_common_ancestor &, const vector<T> &, const T &,
+                  const U &, const Apply &, const Push &, const Combine &)
+    -> subtree_aggregate<T, Combine,
+                         segment_tree_lazy<T, U, Apply, Push, Combine>>;
\ No newline at end of file
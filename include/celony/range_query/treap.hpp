@@ -1,6 +1,8 @@
 #include <bits/stdc++.h>
 using namespace std;
 
+#include <celony/miscellaneous/splitmix64.hpp>
+
 /**
  * @brief Implicit Treap for sequence operations with range queries.
  *
@@ -8,61 +10,121 @@ using namespace std;
  * through subtree sizes. Supports split/merge for flexible range operations,
  * including reversals, insertions, deletions, and range queries.
  *
+ * Nodes live in per-field arrays (structure of arrays) and are linked by
+ * 32-bit indices, with index 0 reserved as the null node. Every array is
+ * contiguous, so the whole treap can be serialized by copying the arrays when
+ * T is trivially copyable.
+ *
  * @tparam T Value type.
  * @tparam Combine Binary associative operation for combining subtree answers.
+ * @tparam U Update/lazy tag type, monostate when range updates are unused.
+ * @tparam Apply Function to apply lazy tag to a subtree: (T, U, size) -> T
+ * @tparam Push Function to combine lazy tags: (U, U, size) -> U
+ * @tparam Rng Priority generator, a UniformRandomBitGenerator.
  *
  * @note All operations are \f$O(\log N)\f$ in expectation due to random
  * priorities.
- * @note Supports lazy propagation through the reversal flag.
+ * @note Supports lazy propagation through the reversal flag, and through
+ * range updates with the same Apply/Push contract as segment_tree_lazy.
  * @note Perfect for problems requiring sequence modifications.
  */
-template <typename T, typename Combine> class treap {
+template <typename T, typename Combine, typename U = monostate,
+          typename Apply = monostate, typename Push = monostate,
+          typename Rng = splitmix64>
+class treap {
+  static constexpr bool lazy = !is_same_v<U, monostate>;
+
 public:
-  struct node {
-    T v, ans;
-    int p = rand(), size{1};
-    bool rev;
-    node *l, *r;
-  } *root = nullptr;
+  using node = uint32_t; // Node index, 0 is the null node.
+
+  node root = 0;
+  vector<node> lc, rc;   // Left and right children.
+  vector<uint32_t> pri;  // Heap priorities.
+  vector<int> sz;        // Subtree sizes.
+  vector<uint8_t> rev;   // Pending reversal flags.
+  vector<T> val, agg;    // Node values and subtree answers.
+  vector<U> tag;         // Pending range updates, tag[0] is the default.
+  vector<uint8_t> has;   // Whether tag holds a pending update.
+  vector<node> released; // Destroyed nodes available for reuse.
 
 private:
+  Apply apply;
+  Push push;
   Combine combine;
+  Rng rng;
+
+  vector<node> path; // Scratch stack shared by the iterative operations.
 
-  static int _size(node *nd) { return nd ? nd->size : 0; }
-  void _push(node *root) {
-    if (root && root->rev) {
-      root->rev = false;
-      swap(root->l, root->r);
-      if (root->l)
-        root->l->rev ^= true;
-      if (root->r)
-        root->r->rev ^= true;
+  void _apply(node x, const U &u) {
+    if (x) {
+      val[x] = apply(val[x], u, 1);
+      agg[x] = apply(agg[x], u, sz[x]);
+      tag[x] = push(tag[x], u, sz[x]);
+      has[x] = true;
     }
-    _update(root);
-  }
-  void _update(node *root) {
-    if (root) {
-      root->size = _size(root->l) + _size(root->r) + 1;
-      root->ans = root->l && root->r ? combine(root->l->ans, root->r->ans)
-                  : root->l          ? root->l->ans
-                  : root->r          ? root->r->ans
-                                     : T{};
-      root->ans = combine(root->ans, root->v);
+  }
+  void _push(node x) {
+    if (rev[x]) {
+      rev[x] = false;
+      swap(lc[x], rc[x]);
+      rev[lc[x]] ^= lc[x] != 0;
+      rev[rc[x]] ^= rc[x] != 0;
+    }
+    if constexpr (lazy) {
+      if (has[x]) {
+        _apply(lc[x], tag[x]);
+        _apply(rc[x], tag[x]);
+        tag[x] = tag[0];
+        has[x] = false;
+      }
     }
   }
-  static void _heapify(node *root) {
-    while (root) {
-      auto mx = root;
-      if (root->l && root->l->p > mx->p)
-        mx = root->l;
-      if (root->r && root->r->p > mx->p)
-        mx = root->r;
-      if (mx == root)
+  void _update(node x) {
+    if (x) {
+      node l = lc[x], r = rc[x];
+      sz[x] = sz[l] + sz[r] + 1;
+      agg[x] = l ? combine(agg[l], val[x]) : val[x];
+      if (r)
+        agg[x] = combine(agg[x], agg[r]);
+    }
+  }
+  void _heapify(node x) {
+    while (x) {
+      node mx = x;
+      if (lc[x] && pri[lc[x]] > pri[mx])
+        mx = lc[x];
+      if (rc[x] && pri[rc[x]] > pri[mx])
+        mx = rc[x];
+      if (mx == x)
         break;
-      swap(root->p, mx->p);
-      root = mx;
+      swap(pri[x], pri[mx]);
+      x = mx;
     }
   }
+  void _init(const vector<T> &v) {
+    lc.push_back(0), rc.push_back(0), pri.push_back(0), sz.push_back(0);
+    rev.push_back(false), val.push_back(T{}), agg.push_back(T{});
+    root = _build(v);
+  }
+  node _build(const vector<T> &v) {
+    int n = v.size(), m = lc.size() + max(0, n - (int)released.size());
+    lc.reserve(m), rc.reserve(m), pri.reserve(m), sz.reserve(m);
+    rev.reserve(m), val.reserve(m), agg.reserve(m);
+    if constexpr (lazy)
+      tag.reserve(m), has.reserve(m);
+    auto build = [&](auto &&self, int l, int r) -> node {
+      if (l == r)
+        return 0;
+      int m = (l + r) / 2;
+      node x = new_node(v[m]);
+      lc[x] = self(self, l, m);
+      rc[x] = self(self, m + 1, r);
+      _heapify(x);
+      _update(x);
+      return x;
+    };
+    return build(build, 0, n);
+  }
 
 public:
   /**
@@ -72,52 +134,93 @@ public:
    *
    * @param v Initial array values.
    * @param combine Binary associative operation for combining subtree answers.
+   * @param rng Priority generator.
    */
-  treap(const vector<T> &v, const Combine &combine) : combine(combine) {
-    int n = v.size();
-    auto build = [&](auto &&self, int l, int r) -> node * {
-      if (l == r)
-        return nullptr;
-      int m = (l + r) / 2;
-      auto root = new node{v[m]};
-      root->l = self(self, l, m);
-      root->r = self(self, m + 1, r);
-      _heapify(root);
-      _update(root);
-      return root;
-    };
-    root = build(build, 0, n);
+  treap(const vector<T> &v, const Combine &combine, const Rng &rng = Rng())
+      : combine(combine), rng(rng) {
+    static_assert(!lazy, "range updates need the constructor taking u0");
+    _init(v);
   }
-  treap(int n, const T &v, const Combine &combine)
-      : treap(vector<T>(n, v), combine) {}
+  treap(int n, const T &v, const Combine &combine, const Rng &rng = Rng())
+      : treap(vector<T>(n, v), combine, rng) {}
+
+  /**
+   * @brief Constructs a treap with lazy range updates from an array.
+   *
+   * Time Complexity: \f$O(N)\f$ expected
+   *
+   * @param v Initial array values.
+   * @param u0 Default lazy tag value.
+   * @param apply Function to apply lazy tag to a subtree: (T, U, size) -> T
+   * @param push Function to combine lazy tags: (U, U, size) -> U
+   * @param combine Binary associative operation for combining subtree answers.
+   * @param rng Priority generator.
+   */
+  treap(const vector<T> &v, const U &u0, const Apply &apply, const Push &push,
+        const Combine &combine, const Rng &rng = Rng())
+      : tag(1, u0), has(1, false), apply(apply), push(push), combine(combine),
+        rng(rng) {
+    _init(v);
+  }
+  treap(int n, const T &v, const U &u0, const Apply &apply, const Push &push,
+        const Combine &combine, const Rng &rng = Rng())
+      : treap(vector<T>(n, v), u0, apply, push, combine, rng) {}
 
   /**
    * @brief Returns a new node with specified value.
    *
-   * Time Complexity: \f$O(1)\f$
+   * Time Complexity: \f$O(1)\f$ amortized
    *
    * @param v Node value.
    */
-  static node *new_node(const T &v) { return new node{v}; }
+  node new_node(const T &v) {
+    if (!released.empty()) {
+      node x = released.back();
+      released.pop_back();
+      lc[x] = rc[x] = 0, pri[x] = uint32_t(rng()), sz[x] = 1, rev[x] = false;
+      val[x] = agg[x] = v;
+      if constexpr (lazy)
+        tag[x] = tag[0], has[x] = false;
+      return x;
+    }
+    lc.push_back(0), rc.push_back(0), pri.push_back(uint32_t(rng()));
+    sz.push_back(1), rev.push_back(false), val.push_back(v), agg.push_back(v);
+    if constexpr (lazy)
+      tag.push_back(tag[0]), has.push_back(false);
+    return lc.size() - 1;
+  }
 
   /**
-   * @brief Destroy the treap.
+   * @brief Destroy the treap, releasing its nodes for reuse.
    *
    * Time Complexity: \f$O(N)\f$
    *
+   * @note Uses an explicit stack, so degenerate treaps cannot overflow the
+   * call stack.
+   *
    * @param root Treap root.
    */
-  static void destroy(node *root) {
-    if (!root)
-      return;
-    destroy(root->l);
-    destroy(root->r);
-    delete root;
+  void destroy(node root) {
+    if (root)
+      path.push_back(root);
+    while (!path.empty()) {
+      node x = path.back();
+      path.pop_back();
+      if (lc[x])
+        path.push_back(lc[x]);
+      if (rc[x])
+        path.push_back(rc[x]);
+      released.push_back(x);
+    }
   }
 
   /**
    * @brief Splits the treap at position k into two treaps.
    *
+   * Descends top-down, hanging nodes onto the rightmost spine of the left
+   * output or the leftmost spine of the right output, then recomputes the
+   * visited nodes bottom-up.
+   *
    * Time Complexity: \f$O(\log N)\f$ expected
    *
    * @param root Root of the treap to split.
@@ -125,26 +228,32 @@ public:
    * @param l Output parameter for the left subtree root.
    * @param r Output parameter for the right subtree root.
    */
-  void split(node *root, int k, node *&l, node *&r) {
-    if (!root) {
-      l = r = nullptr;
-      return;
-    }
-    _push(root);
-    int sz = _size(root->l);
-    if (sz < k) {
-      split(root->r, k - sz - 1, root->r, r);
-      l = root;
-    } else {
-      split(root->l, k, l, root->l);
-      r = root;
+  void split(node root, int k, node &l, node &r) {
+    node tl = 0, tr = 0;
+    while (root) {
+      _push(root);
+      path.push_back(root);
+      if (int s = sz[lc[root]]; s < k) {
+        k -= s + 1;
+        (tl ? rc[tl] : l) = root;
+        tl = exchange(root, rc[root]);
+      } else {
+        (tr ? lc[tr] : r) = root;
+        tr = exchange(root, lc[root]);
+      }
     }
-    _update(root);
+    (tl ? rc[tl] : l) = 0;
+    (tr ? lc[tr] : r) = 0;
+    for (; !path.empty(); path.pop_back())
+      _update(path.back());
   }
 
   /**
    * @brief Merges two treaps into one.
    *
+   * Walks down the right spine of l and the left spine of r by priority,
+   * then recomputes the visited nodes bottom-up.
+   *
    * Time Complexity: \f$O(\log N)\f$ expected
    *
    * @param l Root of the left treap.
@@ -154,19 +263,27 @@ public:
    * @note This implementation assumes all elements in the left treap
    *       come before all elements in the right treap in sequence order.
    */
-  void merge(node *l, node *r, node *&root) {
-    _push(l);
-    _push(r);
-    if (!l || !r)
-      root = l ? l : r;
-    else if (l->p > r->p) {
-      merge(l->r, r, l->r);
-      root = l;
-    } else {
-      merge(l, r->l, r->l);
-      root = r;
+  void merge(node l, node r, node &root) {
+    node t = 0;
+    bool right = false; // whether the next node hangs right of t
+    auto attach = [&](node x) {
+      (!t ? root : right ? rc[t] : lc[t]) = x;
+    };
+    while (l && r) {
+      if (pri[l] > pri[r]) {
+        _push(l);
+        attach(l);
+        t = exchange(l, rc[l]), right = true;
+      } else {
+        _push(r);
+        attach(r);
+        t = exchange(r, lc[r]), right = false;
+      }
+      path.push_back(t);
     }
-    _update(root);
+    attach(l ? l : r);
+    for (; !path.empty(); path.pop_back())
+      _update(path.back());
   }
 
   /**
@@ -178,34 +295,106 @@ public:
    * @param l Left boundary (inclusive, 0-indexed).
    * @param r Right boundary (inclusive, 0-indexed).
    */
-  void reverse(node *root, int l, int r) {
-    node *tl, *tm, *tr;
+  void reverse(node &root, int l, int r) {
+    node tl, tm, tr;
     split(root, l, tl, tm);
     split(tm, r - l + 1, tm, tr);
-    tm->rev ^= true;
+    rev[tm] ^= tm != 0;
     merge(tl, tm, root);
     merge(root, tr, root);
   }
 
   /**
-   * @brief Queries the range [l, r] using the combine operation.
+   * @brief Inserts the values of v before position pos.
+   *
+   * The values are built into a treap in linear time and merged in once.
+   *
+   * Time Complexity: \f$O(K + \log N)\f$ expected, where K is the size of v
+   *
+   * @param root Root of the treap.
+   * @param pos Insert position (0-indexed), v[0] ends up at this position.
+   * @param v Values to insert.
+   */
+  void insert_range(node &root, int pos, const vector<T> &v) {
+    node tl = 0, tr = 0, tm = _build(v);
+    split(root, pos, tl, tr);
+    merge(tl, tm, root);
+    merge(root, tr, root);
+  }
+
+  /**
+   * @brief Applies a lazy update to the range [l, r].
    *
    * Time Complexity: \f$O(\log N)\f$ expected
    *
    * @param root Root of the treap.
    * @param l Left boundary (inclusive, 0-indexed).
    * @param r Right boundary (inclusive, 0-indexed).
-   * @param ans0 Identity value for empty ranges.
-   * @return The combined result of elements [l, r].
+   * @param u Update value to apply.
    */
-  T query(node *root, int l, int r, const T &ans0) {
-    node *tl, *tm, *tr;
+  void update(node &root, int l, int r, const U &u) {
+    node tl = 0, tm = 0, tr = 0;
     split(root, l, tl, tm);
     split(tm, r - l + 1, tm, tr);
-    auto ans = tm ? tm->ans : ans0;
+    _apply(tm, u);
     merge(tl, tm, root);
     merge(root, tr, root);
-    return ans;
+  }
+
+  /**
+   * @brief Queries the range [l, r] using the combine operation.
+   *
+   * Descends from the root without splitting or merging; only pending lazy
+   * tags on the visited nodes are pushed down.
+   *
+   * Time Complexity: \f$O(\log N)\f$ expected
+   *
+   * @param root Root of the treap.
+   * @param l Left boundary (inclusive, 0-indexed).
+   * @param r Right boundary (inclusive, 0-indexed).
+   * @param ans0 Identity of the combine operation, returned for empty ranges.
+   * @return The combined result of elements [l, r].
+   *
+   * @note ans0 is combined on both sides of the range, so it must be an
+   * identity of Combine.
+   */
+  T query(node root, int l, int r, const T &ans0) {
+    node x = root;
+    int s;
+    while (x) {
+      _push(x);
+      if (s = sz[lc[x]]; r < s)
+        x = lc[x];
+      else if (s < l)
+        l -= s + 1, r -= s + 1, x = rc[x];
+      else
+        break;
+    }
+    if (!x)
+      return ans0;
+    T ansl = ans0, ansr = ans0;
+    for (node y = l < s ? lc[x] : 0; y;) {
+      _push(y);
+      int t = sz[lc[y]];
+      if (t < l) {
+        l -= t + 1, y = rc[y];
+        continue;
+      }
+      ansl = combine(rc[y] ? combine(val[y], agg[rc[y]]) : val[y], ansl);
+      y = t == l ? 0 : lc[y];
+    }
+    r -= s + 1;
+    for (node y = r >= 0 ? rc[x] : 0; y;) {
+      _push(y);
+      int t = sz[lc[y]];
+      if (r < t) {
+        y = lc[y];
+        continue;
+      }
+      ansr = combine(ansr, lc[y] ? combine(agg[lc[y]], val[y]) : val[y]);
+      r -= t + 1, y = r >= 0 ? rc[y] : 0;
+    }
+    return combine(combine(ansl, val[x]), ansr);
   }
 
   /**
@@ -216,17 +405,21 @@ public:
    * @param root Root of the treap.
    * @return Vector containing all elements in their sequence order.
    */
-  vector<T> data(node *root) {
+  vector<T> data(node root) {
     vector<T> ans;
-    auto dfs = [&](auto &&self, node *root) -> void {
-      if (!root)
-        return;
-      _push(root);
-      self(self, root->l);
-      ans.push_back(root->v);
-      self(self, root->r);
-    };
-    dfs(dfs, root);
+    ans.reserve(sz[root]);
+    for (node x = root; x || !path.empty();) {
+      if (x) {
+        _push(x);
+        path.push_back(x);
+        x = lc[x];
+      } else {
+        x = path.back();
+        path.pop_back();
+        ans.push_back(val[x]);
+        x = rc[x];
+      }
+    }
     return ans;
   }
-};
+};
\ No newline at end of file
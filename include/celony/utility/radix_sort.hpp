@@ -0,0 +1,65 @@
+#pragma once
+#include <bits/stdc++.h>
+using namespace std;
+
+/**
+ * @brief Stable LSD radix sort of indices by unsigned integer keys.
+ *
+ * Sorts (key, index) pairs one byte at a time with counting sort, so every
+ * pass streams over contiguous memory. Passes over bytes that are equal for
+ * all keys are skipped, so small keys cost fewer passes.
+ *
+ * Time Complexity: \f$O(N \cdot \text{sizeof}(K))\f$
+ * Space Complexity: \f$O(N)\f$
+ *
+ * @tparam K Unsigned integer key type.
+ * @param keys Keys to sort by.
+ * @return Permutation of indices ordering keys increasingly, ties broken by
+ * index.
+ */
+template <typename K> vector<int> radix_order(const vector<K> &keys) {
+  static_assert(is_unsigned_v<K>, "radix_order requires unsigned keys");
+  int n = keys.size();
+  vector<pair<K, int>> a(n), b(n);
+  for (int i = 0; i < n; i++)
+    a[i] = {keys[i], i};
+  for (int d = 0; d < (int)sizeof(K) * 8; d += 8) {
+    array<int, 257> cnt{};
+    for (auto &[k, i] : a)
+      cnt[(k >> d & 255) + 1]++;
+    if (*max_element(cnt.begin(), cnt.end()) == n)
+      continue;
+    partial_sum(cnt.begin(), cnt.end(), cnt.begin());
+    for (auto &e : a)
+      b[cnt[e.first >> d & 255]++] = e;
+    swap(a, b);
+  }
+  vector<int> ord(n);
+  for (int i = 0; i < n; i++)
+    ord[i] = a[i].second;
+  return ord;
+}
+
+/**
+ * @brief Returns the permutation of indices sorting keys increasingly.
+ *
+ * Unsigned integer keys are ordered with radix_order(); other comparable key
+ * types fall back to a comparison sort.
+ *
+ * Time Complexity: \f$O(N \cdot \text{sizeof}(K))\f$ for unsigned keys,
+ * \f$O(N \log N)\f$ otherwise
+ *
+ * @param keys Keys to sort by.
+ * @return Permutation of indices ordering keys increasingly.
+ */
+template <typename V> vector<int> sort_order(const V &keys) {
+  if constexpr (is_unsigned_v<typename V::value_type>)
+    return radix_order(keys);
+  else {
+    vector<int> ord(keys.size());
+    iota(ord.begin(), ord.end(), 0);
+    sort(ord.begin(), ord.end(),
+         [&](int i, int j) { return keys[i] < keys[j]; });
+    return ord;
+  }
+}
\ No newline at end of file
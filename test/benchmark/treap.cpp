@@ -0,0 +1,80 @@
+#include <bits/stdc++.h>
+using namespace std;
+
+#include <celony/range_query/treap.hpp>
+
+// Compares treap priorities drawn from splitmix64 against the global rand().
+// Every thread builds its own treap by n single inserts at random positions,
+// then the depth of every node is measured.
+//
+// Usage: treap_benchmark [n] [max threads]
+
+// rand() as a UniformRandomBitGenerator, the priority source before splitmix64.
+struct libc_rand {
+  using result_type = unsigned;
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return RAND_MAX; }
+  result_type operator()() { return rand(); }
+};
+
+struct result {
+  double seconds;
+  double avg_depth;
+  int max_depth;
+};
+
+template <typename Rng> result run(int n, int threads) {
+  vector<double> avg(threads);
+  vector<int> mx(threads);
+  auto work = [&](int id) {
+    using T = treap<int, plus<int>, monostate, monostate, monostate, Rng>;
+    using node = typename T::node;
+    T t(vector<int>(), plus<int>{});
+    splitmix64 pos(id); // positions come from the same source for both runs
+    for (int i = 0; i < n; i++) {
+      node x = t.new_node(i), l = 0, r = 0;
+      t.split(t.root, pos() % (i + 1), l, r);
+      t.merge(l, x, t.root);
+      t.merge(t.root, r, t.root);
+    }
+    long long sum = 0;
+    vector<pair<node, int>> st{{t.root, 1}};
+    while (!st.empty()) {
+      auto [x, d] = st.back();
+      st.pop_back();
+      if (!x)
+        continue;
+      sum += d;
+      mx[id] = max(mx[id], d);
+      st.push_back({t.lc[x], d + 1});
+      st.push_back({t.rc[x], d + 1});
+    }
+    avg[id] = (double)sum / n;
+  };
+  auto start = chrono::steady_clock::now();
+  vector<thread> pool;
+  for (int id = 0; id < threads; id++)
+    pool.emplace_back(work, id);
+  for (auto &th : pool)
+    th.join();
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+  return {elapsed.count(),
+          accumulate(avg.begin(), avg.end(), 0.0) / threads,
+          *max_element(mx.begin(), mx.end())};
+}
+
+int main(int argc, char **argv) {
+  int n = argc > 1 ? atoi(argv[1]) : 1000000;
+  int max_threads = argc > 2 ? atoi(argv[2])
+                             : max(1u, thread::hardware_concurrency());
+  printf("%-10s %7s %12s %9s %9s\n", "generator", "threads", "inserts/s",
+         "avg depth", "max depth");
+  for (int threads = 1; threads <= max_threads; threads *= 2) {
+    auto print = [&](const char *name, result r) {
+      printf("%-10s %7d %12.0f %9.2f %9d\n", name, threads,
+             (double)n * threads / r.seconds, r.avg_depth, r.max_depth);
+    };
+    print("splitmix64", run<splitmix64>(n, threads));
+    print("rand", run<libc_rand>(n, threads));
+  }
+}
\ No newline at end of file
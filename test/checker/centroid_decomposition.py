@@ -0,0 +1,29 @@
+from test.lib import cli, runner, random
+from random import randint
+
+
+def main():
+    args = cli.args.parse_args()
+    iter = args.iterations
+    for _ in range(iter):
+        stdin = []
+
+        n = randint(1, 2000)
+        q = randint(1, 2 * 10**4)
+        stdin.append(f"{n} {q}")
+
+        ed = random.rand_tree_edges(n)
+        for a, b in ed:
+            stdin.append(f"{a} {b}")
+
+        # Marks are kept rare so that queries have to look far.
+        for _ in range(q):
+            t = 1 if randint(1, 20) == 1 else 2
+            stdin.append(f"{t} {randint(1, n)}")
+
+        proc_ans, sol_ans = runner.run(args.program, args.solution, "\n".join(stdin))
+        assert proc_ans == sol_ans
+
+
+if __name__ == "__main__":
+    main()
@@ -15,7 +15,11 @@ def main():
         v = [str(randint(1, 10**9)) for _ in range(n)]
         stdin.append(" ".join(v))
 
-        ed = random.rand_tree_edges(n)
+        # Every other tree is a caterpillar, up to N deep.
+        if randint(0, 1):
+            ed = random.rand_caterpillar_edges(n)
+        else:
+            ed = random.rand_tree_edges(n)
         for a, b in ed:
             stdin.append(f"{a} {b}")
 
@@ -30,6 +34,38 @@ def main():
                 b = randint(1, n)
                 stdin.append(f"2 {a} {b}")
 
+        # Path and subtree additions and sums on a lazy backing.
+        k = randint(1, 5000)
+        stdin.append(f"{k}")
+        for _ in range(k):
+            type = randint(1, 4)
+            a = randint(1, n)
+            b = randint(1, n)
+            x = randint(-(10**6), 10**6)
+            if type == 1:
+                stdin.append(f"1 {a} {b} {x}")
+            elif type == 2:
+                stdin.append(f"2 {a} {x}")
+            elif type == 3:
+                stdin.append(f"3 {a} {b}")
+            else:
+                stdin.append(f"4 {a}")
+
+        # Affine maps x -> m x + c, a non-commutative path composition.
+        mod = 998244353
+        f = [f"{randint(0, mod - 1)} {randint(0, mod - 1)}" for _ in range(n)]
+        stdin.append(" ".join(f))
+        k = randint(1, 5000)
+        stdin.append(f"{k}")
+        for _ in range(k):
+            type = randint(1, 3)
+            a = randint(1, n)
+            if type == 3:
+                stdin.append(f"3 {a} {randint(1, n)} {randint(0, mod - 1)}")
+            else:
+                m = randint(0, mod - 1)
+                stdin.append(f"{type} {a} {m} {randint(0, mod - 1)}")
+
         proc_ans, sol_ans = runner.run(args.program, args.solution, "\n".join(stdin))
         assert proc_ans == sol_ans
 
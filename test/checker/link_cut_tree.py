@@ -0,0 +1,43 @@
+from test.lib import cli, runner
+from random import choice, randint
+
+
+def main():
+    args = cli.args.parse_args()
+    iter = args.iterations
+    for _ in range(iter):
+        stdin = []
+
+        n = randint(1, 1000)
+        q = randint(1, 10**5)
+        stdin.append(f"{n} {q}")
+
+        a = [str(randint(-(10**9), 10**9)) for _ in range(n)]
+        stdin.append(" ".join(a))
+
+        # Cuts pick from previously attempted links so that most of them hit
+        # an existing edge.
+        linked = []
+        for _ in range(q):
+            t = randint(1, 5)
+            u = randint(1, n)
+            v = randint(1, n)
+            if t == 1:
+                linked.append((u, v))
+                stdin.append(f"1 {u} {v}")
+            elif t == 2 and linked:
+                u, v = choice(linked)
+                stdin.append(f"2 {v} {u}" if randint(0, 1) else f"2 {u} {v}")
+            elif t == 3:
+                stdin.append(f"3 {u} {randint(-(10**9), 10**9)}")
+            elif t == 4:
+                stdin.append(f"4 {u} {v}")
+            else:
+                stdin.append(f"5 {u} {v} {randint(1, n)}")
+
+        proc_ans, sol_ans = runner.run(args.program, args.solution, "\n".join(stdin))
+        assert proc_ans == sol_ans
+
+
+if __name__ == "__main__":
+    main()
@@ -1,12 +1,6 @@
 from test.lib import cli, runner, random
+from math import isqrt
 from random import randint
-import sys
-import resource
-
-sys.setrecursionlimit(10**9)
-resource.setrlimit(
-    resource.RLIMIT_STACK, (resource.RLIM_INFINITY, resource.RLIM_INFINITY)
-)
 
 
 def main():
@@ -19,7 +13,10 @@ def main():
         q = randint(1, 2 * 10**5)
         stdin.append(f"{n} {q}")
 
-        par = random.rand_tree_parent_list(n=n)[1:]
+        # Every other tree is a caterpillar, up to N deep.
+        deep = randint(0, 1)
+        ed = random.rand_caterpillar_edges(n) if deep else None
+        par = random.rand_tree_parent_list(n=n, ed=ed)[1:]
         stdin.append(" ".join(map(str, par)))
 
         for _ in range(q):
@@ -27,6 +24,21 @@ def main():
             b = randint(1, n)
             stdin.append(f"{a} {b}")
 
+        # Random trees are about sqrt(N) deep, so climbs and jumps of up to
+        # 3 sqrt(N) edges often run past the root or the end of the path.
+        h = n if deep else 3 * isqrt(n) + 1
+        k = randint(1, 2 * 10**5)
+        stdin.append(f"{k}")
+        for _ in range(k):
+            type = randint(1, 3)
+            a = randint(1, n)
+            if type == 1:
+                stdin.append(f"1 {a} {randint(-1, h)}")
+            elif type == 2:
+                stdin.append(f"2 {a} {randint(1, n)}")
+            else:
+                stdin.append(f"3 {a} {randint(1, n)} {randint(-1, 2 * h)}")
+
         proc_ans, sol_ans = runner.run(args.program, args.solution, "\n".join(stdin))
         assert proc_ans == sol_ans
 
@@ -1,25 +1,37 @@
 from test.lib import cli, runner
-from random import randint
+from random import choice, randint
 from collections import defaultdict
 
 
+def edge(n: int) -> str:
+    a = randint(1, n)
+    while True:
+        b = randint(1, n)
+        if b != a:
+            break
+    c = randint(1, 10**9)
+    return f"{a} {b} {c}"
+
+
 def main():
     args = cli.args.parse_args()
     iter = args.iterations
     for _ in range(iter):
         stdin = []
 
-        n = randint(1, 500)
+        n = randint(2, 500)
         m = randint(1, 1000)
         stdin.append(f"{n} {m}")
         for _ in range(m):
-            a = randint(1, n)
-            while True:
-                b = randint(1, n)
-                if b != a:
-                    break
-            c = randint(1, 10**9)
-            stdin.append(f"{a} {b} {c}")
+            stdin.append(edge(n))
+
+        # A flow limit that is often below the maximum flow, followed by
+        # edges added after the flow has been computed.
+        m = randint(0, 200)
+        limit = choice([0, randint(1, 10**9), randint(1, 10**10)])
+        stdin.append(f"{limit} {m}")
+        for _ in range(m):
+            stdin.append(edge(n))
 
         proc_ans, sol_ans = runner.run(args.program, args.solution, "\n".join(stdin))
         assert proc_ans == sol_ans
@@ -20,6 +20,17 @@ def main():
             b = randint(a, n)
             stdin.append(f"{a} {b}")
 
+        # Queries interleaved with point updates.
+        k = randint(1, 5000)
+        stdin.append(f"{k}")
+        for _ in range(k):
+            if randint(1, 2) == 1:
+                a = randint(1, n)
+                b = randint(a, n)
+                stdin.append(f"1 {a} {b}")
+            else:
+                stdin.append(f"2 {randint(1, n)} {randint(1, 10**6)}")
+
         proc_ans, sol_ans = runner.run(args.program, args.solution, "\n".join(stdin))
         if proc_ans != sol_ans:
             print(proc_ans)
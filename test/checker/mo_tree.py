@@ -0,0 +1,33 @@
+from test.lib import cli, runner, random
+from random import randint
+
+
+def main():
+    args = cli.args.parse_args()
+    iter = args.iterations
+    for _ in range(iter):
+        stdin = []
+
+        n = randint(1, 2 * 10**5)
+        q = randint(1, 2 * 10**5)
+        stdin.append(f"{n} {q}")
+
+        k = randint(1, n)
+        v = [str(randint(1, k)) for _ in range(n)]
+        stdin.append(" ".join(v))
+
+        ed = random.rand_tree_edges(n)
+        for a, b in ed:
+            stdin.append(f"{a} {b}")
+
+        for _ in range(q):
+            a = randint(1, n)
+            b = randint(1, n)
+            stdin.append(f"{a} {b}")
+
+        proc_ans, sol_ans = runner.run(args.program, args.solution, "\n".join(stdin))
+        assert proc_ans == sol_ans
+
+
+if __name__ == "__main__":
+    main()
@@ -2,26 +2,37 @@ from test.lib import cli, runner
 from random import randint
 
 
+def generate(n: int, q: int) -> str:
+    stdin = []
+    stdin.append(f"{n} {q}")
+
+    t = [randint(1, 10**6) for _ in range(n)]
+    stdin.append(" ".join(map(str, t)))
+
+    for _ in range(q):
+        type = randint(1, 3)
+        a = randint(1, n)
+        b = randint(a, n)
+        if type == 3:
+            stdin.append(f"{type} {a} {b} {randint(-(10**6), 10**6)}")
+        else:
+            stdin.append(f"{type} {a} {b}")
+    return "\n".join(stdin)
+
+
 def main():
     args = cli.args.parse_args()
     iter = args.iterations
     for _ in range(iter):
-        stdin = []
-
         n = randint(1, 2 * 10**5)
         q = randint(1, 2 * 10**5)
-        stdin.append(f"{n} {q}")
-
-        t = [randint(1, 10**6) for _ in range(n)]
-        stdin.append(" ".join(map(str, t)))
-
-        for _ in range(q):
-            type = randint(1, 2)
-            a = randint(1, n)
-            b = randint(a, n)
-            stdin.append(f"{type} {a} {b}")
+        proc_ans, sol_ans = runner.run(args.program, args.solution, generate(n, q))
+        assert proc_ans == sol_ans
 
-        proc_ans, sol_ans = runner.run(args.program, args.solution, "\n".join(stdin))
+        # Small arrays make updates covering the whole tree common.
+        n = randint(1, 8)
+        q = randint(1, 1000)
+        proc_ans, sol_ans = runner.run(args.program, args.solution, generate(n, q))
         assert proc_ans == sol_ans
 
 
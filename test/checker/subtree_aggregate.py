@@ -0,0 +1,39 @@
+from test.lib import cli, runner, random
+from random import randint
+
+
+def main():
+    args = cli.args.parse_args()
+    iter = args.iterations
+    for _ in range(iter):
+        stdin = []
+
+        n = randint(1, 2 * 10**5)
+        q = randint(1, 2 * 10**5)
+        stdin.append(f"{n} {q} {randint(1, n)}")
+
+        a = [str(randint(-(10**9), 10**9)) for _ in range(n)]
+        stdin.append(" ".join(a))
+
+        ed = random.rand_tree_edges(n) if n > 1 else []
+        for a, b in ed:
+            stdin.append(f"{a} {b}")
+
+        # 1: set, 2: add, 3: node and subtree sums on a segment_tree backing,
+        # 4: subtree add, 5: node and subtree sums on a segment_tree_lazy one.
+        for _ in range(q):
+            t = randint(1, 5)
+            v = randint(1, n)
+            if t in (1, 2):
+                stdin.append(f"{t} {v} {randint(-(10**9), 10**9)}")
+            elif t == 4:
+                stdin.append(f"{t} {v} {randint(-(10**6), 10**6)}")
+            else:
+                stdin.append(f"{t} {v}")
+
+        proc_ans, sol_ans = runner.run(args.program, args.solution, "\n".join(stdin))
+        assert proc_ans == sol_ans
+
+
+if __name__ == "__main__":
+    main()
@@ -1,5 +1,6 @@
 from test.lib import cli, runner
-from random import randint
+from random import choices, randint
+from string import ascii_lowercase
 
 
 def main():
@@ -11,11 +12,25 @@ def main():
         n = randint(1, 2 * 10**5)
         q = randint(1, 2 * 10**5)
         stdin.append(f"{n} {q}")
+        stdin.append("".join(choices(ascii_lowercase, k=n)))
 
+        # 1: cut [a, b] and paste it at the end, 2: range add, 3: reverse,
+        # 4: range sum, 5: insert k values before position p.
         for _ in range(q):
+            t = randint(1, 5)
+            if t == 5:
+                p = randint(1, n + 1)
+                k = randint(1, 5)
+                x = [str(randint(-(10**6), 10**6)) for _ in range(k)]
+                stdin.append(f"5 {p} {k} {' '.join(x)}")
+                n += k
+                continue
             a = randint(1, n)
             b = randint(a, n)
-            stdin.append(f"{a} {b}")
+            if t == 2:
+                stdin.append(f"2 {a} {b} {randint(-(10**6), 10**6)}")
+            else:
+                stdin.append(f"{t} {a} {b}")
 
         proc_ans, sol_ans = runner.run(args.program, args.solution, "\n".join(stdin))
         assert proc_ans == sol_ans
@@ -0,0 +1,31 @@
+from test.lib import cli, runner, random
+from random import choice, randint
+
+
+def main():
+    args = cli.args.parse_args()
+    iter = args.iterations
+    for _ in range(iter):
+        stdin = []
+
+        n = randint(1, 2000)
+        q = randint(1, 2000)
+        stdin.append(f"{n} {q}")
+
+        par = random.rand_tree_parent_list(n=n)[1:]
+        stdin.append(" ".join(map(str, par)))
+
+        # Sets range from empty to a few hundred vertices, so that both the
+        # comparison sort and the radix sort are used, and repeat vertices.
+        for _ in range(q):
+            k = choice([0, randint(1, 10), randint(1, 300)])
+            vs = [randint(1, n) for _ in range(k)]
+            vs += [choice(vs) for _ in range(randint(0, k // 2))]
+            stdin.append(" ".join(map(str, [len(vs)] + vs)))
+
+        proc_ans, sol_ans = runner.run(args.program, args.solution, "\n".join(stdin))
+        assert proc_ans == sol_ans
+
+
+if __name__ == "__main__":
+    main()
@@ -31,21 +31,40 @@ def rand_tree_edges(n: int) -> list[tuple[int, int]]:
     return ed
 
 
-def rand_tree_parent_list(n: int, root: int = 1) -> list[int]:
-    ed = rand_tree_edges(n)
+def rand_caterpillar_edges(n: int) -> list[tuple[int, int]]:
+    """
+    Generates a random caterpillar: a path of random length with every other vertex
+    hanging off it. The spine is usually long, which catches recursion that random
+    trees are too shallow to reach. Labels and edge order are shuffled.
+    """
+    perm = sample(range(1, n + 1), n)
+    spine = randint(1, n)
+    ed = [(perm[i - 1], perm[i]) for i in range(1, spine)]
+    ed += [(perm[randint(0, spine - 1)], perm[i]) for i in range(spine, n)]
+    ed = [(b, a) if randint(0, 1) else (a, b) for a, b in ed]
+    return sample(ed, len(ed))
+
+
+def rand_tree_parent_list(
+    n: int, root: int = 1, ed: list[tuple[int, int]] | None = None
+) -> list[int]:
+    if ed is None:
+        ed = rand_tree_edges(n)
     g = [[] for _ in range(n + 1)]
     for a, b in ed:
         g[a].append(b)
         g[b].append(a)
     ans = [-1] * (n + 1)
-
-    def dfs(u, p):
-        ans[u] = p
+    seen = [False] * (n + 1)
+    seen[root] = True
+    stack = [root]
+    while stack:
+        u = stack.pop()
         for v in g[u]:
-            if v != p:
-                dfs(v, u)
-
-    dfs(root, -1)
+            if not seen[v]:
+                seen[v] = True
+                ans[v] = u
+                stack.append(v)
     return ans[1:]
 
 
@@ -1,9 +1,19 @@
+import resource
 import subprocess
 
 
+def _unlimited_stack():
+    resource.setrlimit(
+        resource.RLIMIT_STACK, (resource.RLIM_INFINITY, resource.RLIM_INFINITY)
+    )
+
+
 def run(program: str, solution: str, stdin: str) -> tuple[str, str]:
     """
     Executes a given program and solution with provided stdin.
+
+    Only the solution gets an unlimited stack, for recursive reference code on
+    deep trees. The program keeps the default limit.
     """
 
     input = stdin.encode()
@@ -15,7 +25,9 @@ def run(program: str, solution: str, stdin: str) -> tuple[str, str]:
         raise error
 
     try:
-        sol_output = subprocess.check_output(solution, input=input)
+        sol_output = subprocess.check_output(
+            solution, input=input, preexec_fn=_unlimited_stack
+        )
     except subprocess.CalledProcessError as error:
         print(f"Solution crashed with error: {error.stderr}")
         raise error
@@ -0,0 +1,29 @@
+#include <bits/stdc++.h>
+using namespace std;
+
+#include <celony/graph/centroid_decomposition.hpp>
+
+int main() {
+  cin.tie(0)->sync_with_stdio(false);
+  int n, q;
+  cin >> n >> q;
+  vector<vector<int>> g(n);
+  for (int i = 0; i < n - 1; i++) {
+    int a, b;
+    cin >> a >> b;
+    a--, b--;
+    g[a].push_back(b);
+    g[b].push_back(a);
+  }
+  centroid_decomposition cd(g);
+  cd.mark(0);
+  for (int i = 0; i < q; i++) {
+    int t, v;
+    cin >> t >> v;
+    v--;
+    if (t == 1)
+      cd.mark(v);
+    else
+      cout << cd.nearest(v) << '\n';
+  }
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <bits/stdc++.h>
 using namespace std;
 
+#include <celony/graph/csr_graph.hpp>
 #include <celony/range_query/heavy_light_decomposition.hpp>
 
 int main() {
@@ -12,15 +13,17 @@ int main() {
     cin >> v;
   }
   vector<vector<int>> g(n);
-  for (int i = 0; i < n - 1; i++) {
-    int a, b;
+  vector<pair<int, int>> edges(n - 1);
+  for (auto &[a, b] : edges) {
     cin >> a >> b;
     a--, b--;
     g[a].push_back(b);
     g[b].push_back(a);
   }
-  heavy_light_decomposition hld(g, t, 0,
-                                [](int a, int b) { return max(a, b); });
+  // The same tree built from both graph types, queried alternately.
+  auto mx = [](int a, int b) { return max(a, b); };
+  heavy_light_decomposition hld(g, t, 0, mx);
+  heavy_light_decomposition csr(csr_graph(n, edges), t, 0, mx);
   for (int i = 0; i < q; i++) {
     int t;
     cin >> t;
@@ -29,11 +32,70 @@ int main() {
       cin >> s >> x;
       s--;
       hld.set(s, x);
+      csr.set(s, x);
     } else {
       int a, b;
       cin >> a >> b;
       a--, b--;
-      cout << hld.query(a, b) << ' ';
+      cout << (i % 2 ? csr : hld).query(a, b) << ' ';
+    }
+  }
+  cout << '\n';
+
+  // Path and subtree additions with sums, backed by segment_tree_lazy.
+  vector<long long> w(t.begin(), t.end());
+  auto apply = [](long long v, long long u, int k) { return v + u * k; };
+  auto push = [](long long a, long long b, int) { return a + b; };
+  heavy_light_decomposition lazy(g, w, 0LL, 0LL, apply, push, plus{});
+  int k;
+  cin >> k;
+  for (int i = 0; i < k; i++) {
+    int t, a;
+    cin >> t >> a;
+    a--;
+    if (t == 1) {
+      int b, x;
+      cin >> b >> x;
+      lazy.update_path(a, b - 1, (long long)x);
+    } else if (t == 2) {
+      int x;
+      cin >> x;
+      lazy.update_subtree(a, (long long)x);
+    } else if (t == 3) {
+      int b;
+      cin >> b;
+      cout << lazy.query(a, b - 1) << ' ';
+    } else {
+      cout << lazy.query_subtree(a) << ' ';
+    }
+  }
+  cout << '\n';
+
+  // Affine maps x -> m x + c, composed in path order from a to b.
+  using affine = pair<long long, long long>;
+  auto compose = [](affine f, affine g) -> affine {
+    constexpr long long mod = 998244353;
+    return {g.first * f.first % mod, (g.first * f.second + g.second) % mod};
+  };
+  vector<affine> fs(n);
+  for (auto &[m, c] : fs) {
+    cin >> m >> c;
+  }
+  heavy_light_decomposition<affine, decltype(compose),
+                            segment_tree<affine, decltype(compose)>, false>
+      ordered(g, fs, affine{1, 0}, compose);
+  cin >> k;
+  for (int i = 0; i < k; i++) {
+    int t, a, b, c;
+    cin >> t >> a >> b >> c;
+    a--;
+    if (t == 1) {
+      ordered.set(a, {b, c});
+    } else if (t == 2) {
+      ordered.update(a, {b, c});
+    } else {
+      auto [m, d] = ordered.query(a, b - 1);
+      cout << (m * c + d) % 998244353 << ' ';
     }
   }
   cout << '\n';
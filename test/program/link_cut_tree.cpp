@@ -0,0 +1,38 @@
+#include <bits/stdc++.h>
+using namespace std;
+
+#include <celony/graph/link_cut_tree.hpp>
+
+int main() {
+  cin.tie(0)->sync_with_stdio(false);
+  int n, q;
+  cin >> n >> q;
+  vector<long long> a(n);
+  for (auto &v : a)
+    cin >> v;
+  link_cut_tree lct(a, plus<long long>());
+  for (int i = 0; i < q; i++) {
+    int t, u, v;
+    cin >> t >> u >> v;
+    u--;
+    if (t == 1) {
+      cout << lct.link(u, v - 1) << '\n';
+    } else if (t == 2) {
+      cout << lct.cut(u, v - 1) << '\n';
+    } else if (t == 3) {
+      lct.set(u, v);
+    } else if (t == 4) {
+      cout << (lct.connected(u, v - 1) ? lct.query(u, v - 1) : -1) << '\n';
+    } else {
+      int w;
+      cin >> w;
+      v--, w--;
+      if (!lct.connected(u, v) || !lct.connected(u, w)) {
+        cout << -1 << '\n';
+        continue;
+      }
+      lct.reroot(u);
+      cout << lct.lca(v, w) + 1 << '\n';
+    }
+  }
+}
\ No newline at end of file
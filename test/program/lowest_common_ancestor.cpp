@@ -1,23 +1,59 @@
 #include <bits/stdc++.h>
 using namespace std;
 
+#include <celony/graph/csr_graph.hpp>
 #include <celony/graph/lowest_common_ancestor.hpp>
 
 int main() {
   cin.tie(0)->sync_with_stdio(false);
   int n, q;
   cin >> n >> q;
-  vector<int> p(n + 1);
   vector g(n + 1, vector<int>());
+  vector<pair<int, int>> edges(n - 1);
   for (int i = 0; i < n - 1; i++) {
     int b;
     cin >> b;
     g[b].push_back(i + 2);
+    edges[i] = {b, i + 2};
   }
-  lowest_common_ancestor lca(g, 1);
-  for (int i = 0; i < q; i++) {
-    int a, b;
+  // The same tree built from both graph types, used alternately below.
+  lowest_common_ancestor lca(g, 1), csr(csr_graph(n + 1, edges, true), 1);
+  vector<pair<int, int>> qs(q);
+  for (auto &[a, b] : qs) {
     cin >> a >> b;
-    cout << lca.query(a, b) << '\n';
+  }
+  // Chunks of 1 to 199 queries, alternately answered one by one and as a
+  // batch, so that batches cover every length modulo the prefetch window.
+  for (int i = 0, len = 1, t = 0; i < q; i += len, len = len % 199 + 1, t++) {
+    int j = min(q, i + len);
+    auto &l = t / 2 % 2 ? csr : lca;
+    if (t % 2) {
+      for (int k = i; k < j; k++) {
+        cout << l.query(qs[k].first, qs[k].second) << '\n';
+      }
+    } else {
+      vector<pair<int, int>> batch(qs.begin() + i, qs.begin() + j);
+      for (int v : l.query_batch(batch)) {
+        cout << v << '\n';
+      }
+    }
+  }
+
+  // "1 v k": k-th ancestor, "2 v u": distance, "3 v u d": jump.
+  int k;
+  cin >> k;
+  for (int i = 0; i < k; i++) {
+    int t, v, x;
+    cin >> t >> v >> x;
+    auto &l = i % 2 ? csr : lca;
+    if (t == 1) {
+      cout << l.kth_ancestor(v, x) << '\n';
+    } else if (t == 2) {
+      cout << l.distance(v, x) << '\n';
+    } else {
+      int d;
+      cin >> d;
+      cout << l.jump(v, x, d) << '\n';
+    }
   }
 }
\ No newline at end of file
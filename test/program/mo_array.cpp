@@ -26,13 +26,100 @@ int main() {
     cur_ans += 1LL * cnt[a[i]] * cnt[a[i]] * a[i];
   };
   auto get_answer = [&]() -> long long { return cur_ans; };
-  mo_array<long long> mo(add, remove, get_answer);
-  for (int i = 0; i < q; i++) {
-    int l, r;
+  mo_array mo(add, remove, get_answer);
+  vector<pair<int, int>> qs(q);
+  for (auto &[l, r] : qs) {
     cin >> l >> r;
-    mo.query(l - 1, r - 1);
+    l--, r--;
+    mo.query(l, r);
   }
   for (auto v : mo.solve(&hilbert)) {
     cout << v << ' ';
   }
+  cout << '\n';
+
+  // The same queries with additions and rollbacks only.
+  fill(cnt.begin(), cnt.end(), 0);
+  cur_ans = 0;
+  vector<int> added;                           // values in addition order
+  vector<pair<int, long long>> restore_points; // added.size() and answer
+  auto add_logged = [&](int i) {
+    add(i);
+    added.push_back(a[i]);
+  };
+  auto snapshot = [&]() { restore_points.push_back({added.size(), cur_ans}); };
+  auto rollback = [&]() {
+    auto [k, ans] = restore_points.back();
+    restore_points.pop_back();
+    for (; (int)added.size() > k; added.pop_back())
+      cnt[added.back()]--;
+    cur_ans = ans;
+  };
+  mo_array mo_rb(add_logged, nullptr, get_answer);
+  for (auto [l, r] : qs) {
+    mo_rb.query(l, r);
+  }
+  for (auto v : mo_rb.solve_rollback(snapshot, rollback)) {
+    cout << v << ' ';
+  }
+  cout << '\n';
+
+  // The same queries split across threads, each with its own state.
+  struct state {
+    const vector<int> *a;
+    vector<int> cnt = vector<int>(1e6 + 1);
+    long long cur_ans = 0;
+    void add(int i) {
+      int x = (*a)[i];
+      cur_ans += (2LL * cnt[x]++ + 1) * x;
+    }
+    void erase(int i) {
+      int x = (*a)[i];
+      cur_ans -= (2LL * --cnt[x] + 1) * x;
+    }
+    long long answer() const { return cur_ans; }
+  };
+  mo_array_parallel<state> mo_par(state{&a}, 4);
+  for (auto [l, r] : qs) {
+    mo_par.query(l, r);
+  }
+  for (auto v : mo_par.solve(&hilbert)) {
+    cout << v << ' ';
+  }
+  cout << '\n';
+
+  // Queries "1 l r" interleaved with point updates "2 p x" (a[p] = x).
+  fill(cnt.begin(), cnt.end(), 0);
+  cur_ans = 0;
+  mo_array mo_upd(add, remove, get_answer);
+  vector<array<int, 3>> upd; // position, old value, new value
+  vector<int> cur = a;
+  int k;
+  cin >> k;
+  for (int i = 0; i < k; i++) {
+    int t, x, y;
+    cin >> t >> x >> y;
+    x--;
+    if (t == 1) {
+      mo_upd.query(x, y - 1);
+    } else {
+      upd.push_back({x, cur[x], y});
+      cur[x] = y;
+      mo_upd.update();
+    }
+  }
+  auto set_value = [&](int p, int x, int l, int r) {
+    bool in = l <= p && p <= r;
+    if (in)
+      remove(p);
+    a[p] = x;
+    if (in)
+      add(p);
+  };
+  auto ans = mo_upd.solve_updates(
+      [&](int j, int l, int r) { set_value(upd[j][0], upd[j][2], l, r); },
+      [&](int j, int l, int r) { set_value(upd[j][0], upd[j][1], l, r); });
+  for (auto v : ans) {
+    cout << v << ' ';
+  }
 }
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include <bits/stdc++.h>
+using namespace std;
+
+#include <celony/graph/mo_tree.hpp>
+#include <celony/miscellaneous/hilbert.hpp>
+
+int main() {
+  cin.tie(0)->sync_with_stdio(false);
+  int n, q;
+  cin >> n >> q;
+  vector<int> a(n);
+  for (auto &v : a) {
+    cin >> v;
+  }
+  vector<int> vals = a;
+  sort(vals.begin(), vals.end());
+  for (auto &v : a) {
+    v = lower_bound(vals.begin(), vals.end(), v) - vals.begin();
+  }
+  // Vertex n is isolated from the root and lies on no path, so its value of
+  // its own must never be counted.
+  a.push_back(n);
+  vector<vector<int>> g(n + 1);
+  for (int i = 0; i < n - 1; i++) {
+    int u, v;
+    cin >> u >> v;
+    u--, v--;
+    g[u].push_back(v);
+    g[v].push_back(u);
+  }
+  lowest_common_ancestor lca(g);
+  vector<int> cnt(n + 1);
+  int distinct = 0;
+  auto add = [&](int u) -> void { distinct += cnt[a[u]]++ == 0; };
+  auto remove = [&](int u) -> void { distinct -= --cnt[a[u]] == 0; };
+  auto get_answer = [&]() -> int { return cnt[n] ? -1 : distinct; };
+  mo_tree mo(add, remove, get_answer);
+  for (int i = 0; i < q; i++) {
+    int u, v;
+    cin >> u >> v;
+    mo.add_query(u - 1, v - 1);
+  }
+  for (auto v : mo.solve(&hilbert, lca)) {
+    cout << v << '\n';
+  }
+}
\ No newline at end of file
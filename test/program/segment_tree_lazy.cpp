@@ -36,6 +36,10 @@ int main() {
     a--, b--;
     if (t == 1) {
       seg.update(a, b + 1, D{1, a - 1});
+    } else if (t == 3) {
+      int x;
+      cin >> x;
+      seg.update(a, b + 1, D{0, -x});
     } else {
       cout << seg.query(a, b + 1).s << '\n';
     }
@@ -0,0 +1,48 @@
+#include <bits/stdc++.h>
+using namespace std;
+
+#include <celony/graph/lowest_common_ancestor.hpp>
+#include <celony/range_query/subtree_aggregate.hpp>
+
+int main() {
+  cin.tie(0)->sync_with_stdio(false);
+  int n, q, root;
+  cin >> n >> q >> root;
+  // Vertices are 1-indexed, so vertex 0 is isolated from the root.
+  vector<long long> a(n + 1);
+  for (int i = 1; i <= n; i++)
+    cin >> a[i];
+  vector<vector<int>> g(n + 1);
+  for (int i = 0; i < n - 1; i++) {
+    int u, v;
+    cin >> u >> v;
+    g[u].push_back(v);
+    g[v].push_back(u);
+  }
+  lowest_common_ancestor lca(g, root);
+  subtree_aggregate point(lca, a, 0LL, plus<long long>());
+  auto apply = [](long long v, long long u, int k) { return v + u * k; };
+  auto push = [](long long a, long long b, int) { return a + b; };
+  subtree_aggregate lazy(lca, a, 0LL, 0LL, apply, push, plus<long long>());
+  for (int i = 0; i < q; i++) {
+    int t, v;
+    cin >> t >> v;
+    if (t == 1) {
+      long long x;
+      cin >> x;
+      point.set(v, x);
+    } else if (t == 2) {
+      long long x;
+      cin >> x;
+      point.update(v, x);
+    } else if (t == 3) {
+      cout << point.query(v) << ' ' << point.query_subtree(v) << '\n';
+    } else if (t == 4) {
+      long long x;
+      cin >> x;
+      lazy.update_subtree(v, x);
+    } else {
+      cout << lazy.query(v) << ' ' << lazy.query_subtree(v) << '\n';
+    }
+  }
+}
\ No newline at end of file
@@ -4,25 +4,45 @@ using namespace std;
 #include <celony/range_query/treap.hpp>
 
 int main() {
+  cin.tie(0)->sync_with_stdio(false);
   int n, m;
   string s;
   cin >> n >> m >> s;
-  vector<char> v(s.begin(), s.end());
-  treap t(v, plus{});
+  vector<long long> v(s.begin(), s.end());
+  auto apply = [](long long v, long long u, int k) { return v + u * k; };
+  auto push = [](long long a, long long b, int) { return a + b; };
+  treap t(v, 0LL, apply, push, plus{});
   for (int i = 0; i < m; i++) {
-    int l, r;
-    cin >> l >> r;
+    int type, l, r;
+    cin >> type >> l >> r;
     l--, r--;
-    using node_t = decltype(t)::node;
-    node_t *tl = nullptr, *tm = nullptr, *tr = nullptr;
-    t.split(t.root, l, tl, tm);
-    t.split(tm, r - l + 1, tm, tr);
-    t.merge(tl, tr, t.root);
-    t.merge(t.root, tm, t.root);
+    if (type == 5) {
+      vector<long long> xs(r + 1);
+      for (auto &x : xs) {
+        cin >> x;
+      }
+      t.insert_range(t.root, l, xs);
+    } else if (type == 4) {
+      cout << t.query(t.root, l, r, 0) << ' ';
+    } else if (type == 1) {
+      using node_t = decltype(t)::node;
+      node_t tl = 0, tm = 0, tr = 0;
+      t.split(t.root, l, tl, tm);
+      t.split(tm, r - l + 1, tm, tr);
+      t.merge(tl, tr, t.root);
+      t.merge(t.root, tm, t.root);
+    } else if (type == 2) {
+      long long x;
+      cin >> x;
+      t.update(t.root, l, r, x);
+    } else {
+      t.reverse(t.root, l, r);
+    }
   }
+  cout << '\n';
   auto ans = t.data(t.root);
-  for (char c : ans) {
-    cout << c;
+  for (auto x : ans) {
+    cout << x << ' ';
   }
   cout << '\n';
 }
\ No newline at end of file
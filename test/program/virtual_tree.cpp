@@ -0,0 +1,35 @@
+#include <bits/stdc++.h>
+using namespace std;
+
+#include <celony/graph/lowest_common_ancestor.hpp>
+#include <celony/graph/virtual_tree.hpp>
+
+int main() {
+  cin.tie(0)->sync_with_stdio(false);
+  int n, q;
+  cin >> n >> q;
+  vector g(n + 1, vector<int>());
+  for (int i = 0; i < n - 1; i++) {
+    int b;
+    cin >> b;
+    g[b].push_back(i + 2);
+  }
+  lowest_common_ancestor lca(g, 1);
+  for (int i = 0; i < q; i++) {
+    int k;
+    cin >> k;
+    vector<int> vs(k);
+    for (auto &v : vs)
+      cin >> v;
+    auto [nodes, tree] = virtual_tree(lca, vs);
+    int m = nodes.size();
+    vector<int> par(m, 0);
+    for (int u = 0; u < m; u++)
+      for (int v : tree[u])
+        par[v] = nodes[u];
+    cout << m;
+    for (int u = 0; u < m; u++)
+      cout << ' ' << nodes[u] << ' ' << par[u];
+    cout << '\n';
+  }
+}
\ No newline at end of file
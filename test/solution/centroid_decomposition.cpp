@@ -0,0 +1,46 @@
+// Brute force: runs a BFS from the queried vertex until a marked vertex is
+// reached.
+
+#include <iostream>
+#include <vector>
+using namespace std;
+
+int main() {
+  cin.tie(0)->sync_with_stdio(false);
+  int n, q;
+  cin >> n >> q;
+  vector<vector<int>> g(n);
+  for (int i = 0; i < n - 1; i++) {
+    int a, b;
+    cin >> a >> b;
+    a--, b--;
+    g[a].push_back(b);
+    g[b].push_back(a);
+  }
+  vector<bool> marked(n);
+  marked[0] = true;
+  for (int i = 0; i < q; i++) {
+    int t, v;
+    cin >> t >> v;
+    v--;
+    if (t == 1) {
+      marked[v] = true;
+      continue;
+    }
+    vector<int> dist(n, -1), bfs{v};
+    dist[v] = 0;
+    for (int j = 0; j < (int)bfs.size(); j++) {
+      int u = bfs[j];
+      if (marked[u]) {
+        cout << dist[u] << '\n';
+        break;
+      }
+      for (int w : g[u]) {
+        if (dist[w] == -1) {
+          dist[w] = dist[u] + 1;
+          bfs.push_back(w);
+        }
+      }
+    }
+  }
+}
\ No newline at end of file
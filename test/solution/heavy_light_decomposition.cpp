@@ -159,4 +159,90 @@ int main() {
       cout << ans << '\n';
     }
   }
+
+  // The remaining sections are answered by brute force over the
+  // decomposition's parents and DFS order.
+  vector<int> node(n);
+  for (int i = 0; i < n; ++i) {
+    node[hld.position(i)] = i;
+  }
+  auto is_ancestor = [&](int a, int b) {
+    auto [l, r] = hld.subtree(a);
+    return l <= hld.position(b) && hld.position(b) <= r;
+  };
+  // Nodes on the path from a to b, in order.
+  auto path = [&](int a, int b) {
+    vector<int> up, down;
+    for (; !is_ancestor(a, b); a = hld.parent[a]) {
+      up.push_back(a);
+    }
+    for (; b != a; b = hld.parent[b]) {
+      down.push_back(b);
+    }
+    up.push_back(a);
+    up.insert(up.end(), down.rbegin(), down.rend());
+    return up;
+  };
+
+  // Path and subtree additions with sums.
+  vector<long long> w(v.begin(), v.end());
+  int k;
+  cin >> k;
+  for (int i = 0; i < k; ++i) {
+    int t, a;
+    cin >> t >> a;
+    a--;
+    if (t == 1 || t == 3) {
+      int b;
+      cin >> b;
+      long long x = 0, sum = 0;
+      if (t == 1) {
+        cin >> x;
+      }
+      for (int u : path(a, b - 1)) {
+        w[u] += x;
+        sum += w[u];
+      }
+      if (t == 3) {
+        cout << sum << '\n';
+      }
+    } else {
+      auto [l, r] = hld.subtree(a);
+      long long x = 0, sum = 0;
+      if (t == 2) {
+        cin >> x;
+      }
+      for (int j = l; j <= r; ++j) {
+        w[node[j]] += x;
+        sum += w[node[j]];
+      }
+      if (t == 4) {
+        cout << sum << '\n';
+      }
+    }
+  }
+
+  // Affine maps x -> m x + c, applied in path order from a to b.
+  const long long mod = 998244353;
+  vector<long long> fm(n), fc(n);
+  for (int i = 0; i < n; ++i) {
+    cin >> fm[i] >> fc[i];
+  }
+  cin >> k;
+  for (int i = 0; i < k; ++i) {
+    int t, a, b, c;
+    cin >> t >> a >> b >> c;
+    a--;
+    if (t == 1) {
+      fm[a] = b, fc[a] = c;
+    } else if (t == 2) {
+      fm[a] = fm[a] * b % mod, fc[a] = (fc[a] * b + c) % mod;
+    } else {
+      long long x = c;
+      for (int u : path(a, b - 1)) {
+        x = (fm[u] * x + fc[u]) % mod;
+      }
+      cout << x << '\n';
+    }
+  }
 }
\ No newline at end of file
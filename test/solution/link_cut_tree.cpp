@@ -0,0 +1,86 @@
+// Brute force: keeps adjacency sets and finds every path with a BFS.
+
+#include <iostream>
+#include <set>
+#include <vector>
+using namespace std;
+
+int n;
+vector<set<int>> g;
+
+// Parents in the BFS tree rooted at s, -1 for s and -2 if unreachable.
+vector<int> bfs(int s) {
+  vector<int> par(n, -2), q{s};
+  par[s] = -1;
+  for (int i = 0; i < (int)q.size(); i++) {
+    for (int v : g[q[i]]) {
+      if (par[v] == -2) {
+        par[v] = q[i];
+        q.push_back(v);
+      }
+    }
+  }
+  return par;
+}
+
+int main() {
+  cin.tie(0)->sync_with_stdio(false);
+  int q;
+  cin >> n >> q;
+  vector<long long> a(n);
+  for (auto &v : a) {
+    cin >> v;
+  }
+  g.resize(n);
+  for (int i = 0; i < q; i++) {
+    int t, u, v;
+    cin >> t >> u >> v;
+    u--;
+    if (t == 1) {
+      v--;
+      bool ok = bfs(u)[v] == -2;
+      if (ok) {
+        g[u].insert(v);
+        g[v].insert(u);
+      }
+      cout << ok << '\n';
+    } else if (t == 2) {
+      v--;
+      bool ok = g[u].erase(v);
+      g[v].erase(u);
+      cout << ok << '\n';
+    } else if (t == 3) {
+      a[u] = v;
+    } else if (t == 4) {
+      v--;
+      vector<int> par = bfs(u);
+      if (par[v] == -2) {
+        cout << -1 << '\n';
+        continue;
+      }
+      long long sum = 0;
+      for (int x = v; x != -1; x = par[x]) {
+        sum += a[x];
+      }
+      cout << sum << '\n';
+    } else {
+      int w;
+      cin >> w;
+      v--, w--;
+      vector<int> par = bfs(u);
+      if (par[v] == -2 || par[w] == -2) {
+        cout << -1 << '\n';
+        continue;
+      }
+      vector<bool> seen(n);
+      for (int x = v; x != -1; x = par[x]) {
+        seen[x] = true;
+      }
+      int x = w;
+      while (!seen[x]) {
+        x = par[x];
+      }
+      cout << x + 1 << '\n';
+    }
+  }
+}
\ No newline at end of file
@@ -65,4 +65,40 @@ int main() {
     b--;
     cout << lca(a, b) + 1 << '\n';
   }
+
+  // k-th ancestors, distances and jumps by binary lifting, 1-indexed output
+  // with -1 when out of range.
+  auto kth = [&](int a, int k) {
+    if (k < 0 || k > depth[a]) {
+      return -2;
+    }
+    for (int j = 19; j >= 0; --j) {
+      if ((1 << j) & k) {
+        a = jmp[a][j];
+      }
+    }
+    return a;
+  };
+  int k;
+  cin >> k;
+  for (int qi = 0; qi < k; ++qi) {
+    int t, a, b;
+    cin >> t >> a >> b;
+    a--;
+    if (t == 1) {
+      cout << kth(a, b) + 1 << '\n';
+      continue;
+    }
+    b--;
+    int c = lca(a, b), da = depth[a] - depth[c], db = depth[b] - depth[c];
+    if (t == 2) {
+      cout << da + db << '\n';
+    } else {
+      int d;
+      cin >> d;
+      int ans = d < 0 || d > da + db ? -2 : d <= da ? kth(a, d)
+                                                    : kth(b, da + db - d);
+      cout << ans + 1 << '\n';
+    }
+  }
 }
\ No newline at end of file
@@ -69,14 +69,30 @@ int main() {
     int n, m;
     cin >> n >> m;
 
-    MaxFlow flow(n, 0, n - 1);
+    MaxFlow flow(n, 0, n - 1), flow_more(n, 0, n - 1);
     for (int i = 0; i < m; ++i) {
         int a, b, w;
         cin >> a >> b >> w;
         a--;
         b--;
         flow.add_edge(a, b, w, 0);
+        flow_more.add_edge(a, b, w, 0);
     }
 
-    cout << flow.max_flow() << '\n';
+    // The program computes a flow limited to `limit`, the rest of it, and
+    // then the flow gained by more edges, once for each algorithm.
+    ll limit;
+    cin >> limit >> m;
+    for (int i = 0; i < m; ++i) {
+        int a, b, w;
+        cin >> a >> b >> w;
+        a--;
+        b--;
+        flow_more.add_edge(a, b, w, 0);
+    }
+    ll f = flow.max_flow(), f_more = flow_more.max_flow();
+    ll l = min(limit, f);
+    for (int i = 0; i < 5; ++i) {
+        cout << f << ' ' << l << ' ' << f - l << ' ' << f_more - f << '\n';
+    }
 }
\ No newline at end of file
@@ -38,6 +38,26 @@ int main() {
       add(a[r--], -1);
     ans[q[i].p] = now;
   }
-  for (i = 1; i <= m; i++)
-    cout << ans[i] << "\n";
+  // Printed once for each solver of the program.
+  for (int k = 0; k < 3; k++)
+    for (i = 1; i <= m; i++)
+      cout << ans[i] << "\n";
+
+  // Queries interleaved with point updates, answered by brute force.
+  int k, t, x, y;
+  cin >> k;
+  memset(cnt, 0, sizeof cnt);
+  while (k--) {
+    cin >> t >> x >> y;
+    if (t == 2) {
+      a[x] = y;
+      continue;
+    }
+    now = 0;
+    for (i = x; i <= y; i++)
+      add(a[i], 1);
+    cout << now << "\n";
+    for (i = x; i <= y; i++)
+      add(a[i], -1);
+  }
 }
\ No newline at end of file
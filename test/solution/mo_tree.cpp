@@ -0,0 +1,64 @@
+// Brute force: walks every path through parent pointers, which is fast
+// enough since random trees have O(sqrt(N)) height.
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+int main() {
+  cin.tie(0)->sync_with_stdio(false);
+  int n, q;
+  cin >> n >> q;
+  vector<int> a(n);
+  for (auto &v : a) {
+    cin >> v;
+  }
+  vector<vector<int>> g(n);
+  for (int i = 0; i < n - 1; i++) {
+    int u, v;
+    cin >> u >> v;
+    u--, v--;
+    g[u].push_back(v);
+    g[v].push_back(u);
+  }
+  vector<int> par(n, -1), depth(n), order{0};
+  par[0] = 0;
+  for (int i = 0; i < (int)order.size(); i++) {
+    int u = order[i];
+    for (int v : g[u]) {
+      if (par[v] == -1) {
+        par[v] = u;
+        depth[v] = depth[u] + 1;
+        order.push_back(v);
+      }
+    }
+  }
+  vector<int> vals = a;
+  sort(vals.begin(), vals.end());
+  for (auto &v : a) {
+    v = lower_bound(vals.begin(), vals.end(), v) - vals.begin();
+  }
+  vector<int> seen(n, -1);
+  for (int i = 0; i < q; i++) {
+    int u, v;
+    cin >> u >> v;
+    u--, v--;
+    int ans = 0;
+    auto visit = [&](int x) {
+      if (seen[a[x]] != i) {
+        seen[a[x]] = i;
+        ans++;
+      }
+    };
+    while (u != v) {
+      if (depth[u] < depth[v]) {
+        swap(u, v);
+      }
+      visit(u);
+      u = par[u];
+    }
+    visit(u);
+    cout << ans << '\n';
+  }
+}
\ No newline at end of file
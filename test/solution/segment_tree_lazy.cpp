@@ -6,9 +6,9 @@ using namespace std;
 using ll = long long;
 
 // This lazy segment tree implementation supports the following operations:
-//  1. add(l, r, x): in range [l, r), add x + 0 to the first element,
-//                                        x + 1 to the second,
-//                                        x + 2 to the third and so on
+//  1. add(l, r, x, d): in range [l, r), add x + 0d to the first element,
+//                                           x + 1d to the second,
+//                                           x + 2d to the third and so on
 //  3. query(l, r): find the sum of values in range [l, r)
 struct Tree {
   int n;
@@ -18,17 +18,17 @@ struct Tree {
 
   Tree(int n) : n(n), sum(n * 4), lazy_a(n * 4), lazy_d(n * 4) {}
 
-  void add(int s, int l, int r, int ql, int qr, int x) {
+  void add(int s, int l, int r, int ql, int qr, int x, int d) {
     if (r <= ql || qr <= l)
       return;
     if (ql <= l && r <= qr) {
-      apply(s, r - l, x + (l - ql), 1);
+      apply(s, r - l, x + ll(l - ql) * d, d);
       return;
     }
     push(s, r - l);
     int m = (l + r) / 2;
-    add(s * 2 + 0, l, m, ql, qr, x);
-    add(s * 2 + 1, m, r, ql, qr, x);
+    add(s * 2 + 0, l, m, ql, qr, x, d);
+    add(s * 2 + 1, m, r, ql, qr, x, d);
     sum[s] = sum[s * 2] + sum[s * 2 + 1];
   }
 
@@ -55,7 +55,7 @@ struct Tree {
     lazy_d[s] += d;
   }
 
-  void add(int l, int r, int x) { add(1, 0, n, l, r, x); }
+  void add(int l, int r, int x, int d = 1) { add(1, 0, n, l, r, x, d); }
   ll query(int l, int r) { return query(1, 0, n, l, r); }
 };
 
@@ -77,6 +77,10 @@ int main() {
     l--;
     if (t == 1) {
       tree.add(l, r, 1);
+    } else if (t == 3) {
+      int x;
+      cin >> x;
+      tree.add(l, r, x, 0);
     } else {
       cout << tree.query(l, r) << '\n';
     }
@@ -0,0 +1,61 @@
+// Brute force: numbers the vertices in DFS order and loops over the range of
+// every queried or updated subtree.
+
+#include <iostream>
+#include <vector>
+using namespace std;
+
+int main() {
+  cin.tie(0)->sync_with_stdio(false);
+  int n, q, root;
+  cin >> n >> q >> root;
+  root--;
+  vector<long long> a(n);
+  for (auto &v : a)
+    cin >> v;
+  vector<vector<int>> g(n);
+  for (int i = 0; i < n - 1; i++) {
+    int u, v;
+    cin >> u >> v;
+    u--, v--;
+    g[u].push_back(v);
+    g[v].push_back(u);
+  }
+  vector<int> order, id(n), size(n, 1), parent(n, -1), stack{root};
+  while (!stack.empty()) {
+    int u = stack.back();
+    stack.pop_back();
+    id[u] = order.size();
+    order.push_back(u);
+    for (int v : g[u]) {
+      if (v != parent[u]) {
+        parent[v] = u;
+        stack.push_back(v);
+      }
+    }
+  }
+  for (int i = n - 1; i > 0; i--)
+    size[parent[order[i]]] += size[order[i]];
+  vector<long long> b = a; // values of the lazy structure
+  for (int i = 0; i < q; i++) {
+    int t, v;
+    cin >> t >> v;
+    v--;
+    if (t == 1 || t == 2) {
+      long long x;
+      cin >> x;
+      a[v] = t == 1 ? x : a[v] + x;
+      continue;
+    }
+    vector<long long> &c = t <= 3 ? a : b;
+    long long x = 0, sum = 0;
+    if (t == 4)
+      cin >> x;
+    for (int j = id[v]; j < id[v] + size[v]; j++) {
+      c[order[j]] += x;
+      sum += c[order[j]];
+    }
+    if (t != 4)
+      cout << c[v] << ' ' << sum << '\n';
+  }
+}
\ No newline at end of file
@@ -1,25 +1,49 @@
 // https://cses.fi/problemset/model/2072/
+// Extended with lazy range additions, reversals, range sums and insertions.
 
 #include <chrono>
 #include <iostream>
 #include <random>
 #include <tuple>
 using namespace std;
+using ll = long long;
 
 mt19937 rng(chrono::high_resolution_clock::now().time_since_epoch().count());
 
 struct Treap {
   Treap *left = nullptr, *right = nullptr;
-  int v, weight, sz = 1;
+  int weight, sz = 1;
+  ll v, sum, add = 0;
+  bool rev = false;
   Treap() {}
-  Treap(int v) : v(v), weight(rng()) {}
+  Treap(ll v) : weight(rng()), v(v), sum(v) {}
+
+  static void apply(Treap *node, ll add, bool rev) {
+    if (node) {
+      node->v += add;
+      node->sum += add * node->sz;
+      node->add += add;
+      if (rev) {
+        swap(node->left, node->right);
+        node->rev ^= 1;
+      }
+    }
+  }
+
+  static void push(Treap *node) {
+    apply(node->left, node->add, node->rev);
+    apply(node->right, node->add, node->rev);
+    node->add = 0;
+    node->rev = false;
+  }
 
   static void update(Treap *node) {
     node->sz = 1;
+    node->sum = node->v;
     if (node->left)
-      node->sz += node->left->sz;
+      node->sz += node->left->sz, node->sum += node->left->sum;
     if (node->right)
-      node->sz += node->right->sz;
+      node->sz += node->right->sz, node->sum += node->right->sum;
   }
 
   // Merges the treaps a and b.
@@ -30,9 +54,11 @@ struct Treap {
       return a;
     Treap *r;
     if (a->weight < b->weight) {
+      push(a);
       a->right = merge(a->right, b);
       r = a;
     } else {
+      push(b);
       b->left = merge(a, b->left);
       r = b;
     }
@@ -45,6 +71,7 @@ struct Treap {
   static pair<Treap *, Treap *> split(Treap *a, int k) {
     if (!a)
       return {nullptr, nullptr};
+    push(a);
     int al = a->left ? a->left->sz : 0;
     Treap *r;
     if (al >= k) {
@@ -58,9 +85,10 @@ struct Treap {
   }
 
   static void print(Treap *a, char endl = '\n') {
+    push(a);
     if (a->left)
       print(a->left, '\0');
-    cout << (char)a->v;
+    cout << a->v << ' ';
     if (a->right)
       print(a->right, '\0');
     if (endl)
@@ -68,8 +96,8 @@ struct Treap {
   }
 };
 
-Treap *new_treap(int v) {
-  const int pool_sz = 2e5;
+Treap *new_treap(ll v) {
+  const int pool_sz = 12e5;
   static Treap pool[pool_sz];
   static Treap *pool_ptr = pool;
 
@@ -91,13 +119,37 @@ int main() {
   }
 
   for (int i = 0; i < m; ++i) {
-    int a, b;
-    cin >> a >> b;
+    int t, a, b;
+    cin >> t >> a >> b;
+    if (t == 5) {
+      auto [r0, r1] = Treap::split(root, a - 1);
+      for (int j = 0; j < b; j++) {
+        ll x;
+        cin >> x;
+        r0 = Treap::merge(r0, new_treap(x));
+      }
+      root = Treap::merge(r0, r1);
+      continue;
+    }
     auto [r0, r1] = Treap::split(root, a - 1);
     auto [r2, r3] = Treap::split(r1, b - a + 1);
-    root = Treap::merge(r0, r3);
-    root = Treap::merge(root, r2);
+    if (t == 1) {
+      root = Treap::merge(r0, r3);
+      root = Treap::merge(root, r2);
+      continue;
+    }
+    if (t == 2) {
+      ll x;
+      cin >> x;
+      Treap::apply(r2, x, false);
+    } else if (t == 3) {
+      Treap::apply(r2, 0, true);
+    } else {
+      cout << r2->sum << ' ';
+    }
+    root = Treap::merge(r0, Treap::merge(r2, r3));
   }
 
+  cout << '\n';
   Treap::print(root);
 }
\ No newline at end of file
@@ -0,0 +1,63 @@
+// Brute force: keeps every vertex that is in the set or joins the subtrees of
+// two of its children containing set vertices, then finds parents and the
+// preorder with a full DFS per query.
+
+#include <iostream>
+#include <vector>
+using namespace std;
+
+int main() {
+  cin.tie(0)->sync_with_stdio(false);
+  int n, q;
+  cin >> n >> q;
+  vector<vector<int>> g(n + 1);
+  for (int i = 0; i < n - 1; i++) {
+    int b;
+    cin >> b;
+    g[b].push_back(i + 2);
+  }
+  // Preorder with children in input order, as the tree is given.
+  vector<int> order, stack{1};
+  while (!stack.empty()) {
+    int u = stack.back();
+    stack.pop_back();
+    order.push_back(u);
+    for (int i = g[u].size() - 1; i >= 0; i--)
+      stack.push_back(g[u][i]);
+  }
+  vector<int> parent(n + 1);
+  for (int u = 1; u <= n; u++)
+    for (int v : g[u])
+      parent[v] = u;
+  for (int i = 0; i < q; i++) {
+    int k;
+    cin >> k;
+    vector<bool> marked(n + 1);
+    for (int j = 0; j < k; j++) {
+      int v;
+      cin >> v;
+      marked[v] = true;
+    }
+    vector<int> below(n + 1), branches(n + 1);
+    for (int j = n - 1; j >= 0; j--) {
+      int u = order[j];
+      below[u] += marked[u];
+      if (j > 0 && below[u] > 0) {
+        below[parent[u]] += below[u];
+        branches[parent[u]]++;
+      }
+    }
+    vector<int> keep(n + 1), up(n + 1), nodes;
+    for (int u : order) {
+      keep[u] = marked[u] || branches[u] >= 2;
+      int p = u == 1 ? 0 : parent[u];
+      up[u] = p == 0 ? 0 : keep[p] ? p : up[p];
+      if (keep[u])
+        nodes.push_back(u);
+    }
+    cout << nodes.size();
+    for (int u : nodes)
+      cout << ' ' << u << ' ' << up[u];
+    cout << '\n';
+  }
+}
\ No newline at end of file
@@ -23,12 +23,27 @@ function library_target(name)
         end)
 end
 
+-- Benchmarks are built on demand and run by hand, e.g.
+-- xmake build treap_benchmark && xmake run treap_benchmark
+function benchmark_target(name)
+    target(name .. "_benchmark")
+        set_kind("binary")
+        set_default(false)
+        set_optimize("fastest")
+        add_files("benchmark/" .. name .. ".cpp")
+        add_syslinks("pthread")
+end
+
 -- graph
 library_target("bridges")
+library_target("centroid_decomposition")
+library_target("link_cut_tree")
 library_target("lowest_common_ancestor")
 library_target("max_flow")
+library_target("mo_tree")
 library_target("strongly_connected_components")
 library_target("union_find")
+library_target("virtual_tree")
 
 -- math
 library_target("combinatorics")
@@ -41,9 +56,12 @@ library_target("mo_array")
 library_target("segment_tree")
 library_target("segment_tree_lazy")
 library_target("sparse_table")
+library_target("subtree_aggregate")
 library_target("treap")
 
 -- string
 library_target("aho_corasick")
 library_target("rolling_hash")
 
+-- benchmarks
+benchmark_target("treap")